@@ -0,0 +1,204 @@
+/* arena.c
+ *
+ * Arena (aka region) allocator for temporary objects.
+ *
+ * Most objects which are created during the evaluation of an expression,
+ * like the result of 'a * b' in 'a * b + c', only live until the statement
+ * in which they were created has been executed. Allocating these with
+ * calloc() and releasing them with free() is relatively expensive. Instead
+ * they are allocated from an arena by just bumping a pointer.
+ *
+ * Before executing a statement the parser sets a mark. After the statement
+ * has been executed the mark is released, which frees all memory that was
+ * allocated from the arena since setting the mark in one go. As statements
+ * are nested (think of the statements in a function called from within an
+ * expression) marks are nested too, so releasing a mark only frees the
+ * memory allocated after it.
+ *
+ * An object which must outlive the statement in which it was created
+ * - because it is bound to an identifier, stored in a list or returned from
+ * a function - is first copied to the heap (see obj_promote() in object.c).
+ *
+ * The arena consists of a list of chunks. Chunks are never returned to the
+ * operating system but are reused after a mark has been released.
+ *
+ * For debugging the arena can be disabled by defining preprocessor macro
+ * NOARENA. All objects are then allocated on the heap.
+ *
+ * 2020	K.W.E. de Lange
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "arena.h"
+#include "error.h"
+
+#define CHUNKSIZE	65536	/* default number of bytes in a chunk */
+#define ALIGNMENT	8		/* all allocations are a multiple of this */
+
+
+typedef struct chunk {
+	struct chunk *next;		/* next chunk, NULL for last chunk */
+	size_t size;			/* number of bytes in data[] */
+	size_t used;			/* number of bytes in use in data[] */
+	char data[];
+} Chunk;
+
+
+/* Create a new chunk with room for at least size bytes.
+ */
+static Chunk *new_chunk(size_t size)
+{
+	Chunk *chunk;
+
+	if (size < CHUNKSIZE)
+		size = CHUNKSIZE;
+
+	if ((chunk = malloc(sizeof(Chunk) + size)) == NULL)
+		error(OutOfMemoryError);
+
+	chunk->next = NULL;
+	chunk->size = size;
+	chunk->used = 0;
+
+	return chunk;
+}
+
+
+/* Make the chunk following the current chunk the current chunk. If this
+ * chunk is not large enough to hold size bytes then a new chunk is inserted.
+ */
+static void next_chunk(size_t size)
+{
+	Chunk *chunk;
+
+	if (arena.current == NULL) {
+		if (arena.first == NULL)
+			arena.first = new_chunk(size);
+		chunk = arena.first;
+	} else
+		chunk = arena.current->next;
+
+	if (chunk == NULL || chunk->size < size) {
+		chunk = new_chunk(size);
+		if (arena.current == NULL) {
+			chunk->next = arena.first;
+			arena.first = chunk;
+		} else {
+			chunk->next = arena.current->next;
+			arena.current->next = chunk;
+		}
+	}
+	chunk->used = 0;
+	arena.current = chunk;
+}
+
+
+/* API: Allocate size bytes of zeroed memory from the arena.
+ *
+ * size     number of bytes to allocate
+ * return   pointer to the memory or NULL if the heap must be used
+ */
+static void *alloc(size_t size)
+{
+#ifdef NOARENA
+	(void)size;
+	return NULL;
+#else
+	void *ptr;
+
+	if (arena.level == 0 || arena.suspended)
+		return NULL;
+
+	size = (size + ALIGNMENT - 1) & ~(size_t)(ALIGNMENT - 1);
+
+	if (arena.current == NULL || arena.current->used + size > arena.current->size)
+		next_chunk(size);
+
+	ptr = arena.current->data + arena.current->used;
+	arena.current->used += size;
+
+	memset(ptr, 0, size);
+
+	return ptr;
+#endif
+}
+
+
+/* API: Check if ptr points to memory which was allocated from the arena.
+ */
+static bool owns(const void *ptr)
+{
+	for (Chunk *chunk = arena.first; chunk; chunk = chunk->next)
+		if ((const char *)ptr >= chunk->data && (const char *)ptr < chunk->data + chunk->size)
+			return true;
+
+	return false;
+}
+
+
+/* API: Start a new region in the arena.
+ *
+ * return   mark to pass to release() at the end of the region
+ */
+static ArenaMark mark(void)
+{
+	ArenaMark m = { .chunk = NULL, .used = 0 };
+
+	if (arena.current) {
+		m.chunk = arena.current;
+		m.used = arena.current->used;
+	}
+	arena.level++;
+
+	return m;
+}
+
+
+/* API: Free all memory which was allocated since mark m was set.
+ */
+static void release(ArenaMark m)
+{
+	if (m.chunk == NULL) {
+		arena.current = arena.first;
+		if (arena.current)
+			arena.current->used = 0;
+	} else {
+		arena.current = m.chunk;
+		arena.current->used = m.used;
+	}
+	arena.level--;
+}
+
+
+/* API: Temporarily allocate from the heap instead of from the arena.
+ */
+static void suspend(void)
+{
+	arena.suspended++;
+}
+
+
+/* API: Undo a call to suspend().
+ */
+static void resume(void)
+{
+	arena.suspended--;
+}
+
+
+/* Arena API and data, including the initial settings.
+ */
+Arena arena = {
+	.first = NULL,
+	.current = NULL,
+	.level = 0,
+	.suspended = 0,
+
+	.alloc = alloc,
+	.owns = owns,
+	.mark = mark,
+	.release = release,
+	.suspend = suspend,
+	.resume = resume
+	};
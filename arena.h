@@ -0,0 +1,42 @@
+/* arena.h
+ *
+ * 2020	K.W.E. de Lange
+ */
+#ifndef _ARENA_
+#define _ARENA_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/* A mark records how much of the arena was in use at a certain moment.
+ * Releasing a mark frees everything which was allocated after it.
+ */
+typedef struct {
+	struct chunk *chunk;	/* chunk in use when the mark was set */
+	size_t used;			/* number of bytes in use in this chunk */
+} ArenaMark;
+
+/* This struct is the API to the arena, containing both data and
+ * function adresses.
+ *
+ * Function alloc() returns zeroed memory from the arena, or NULL if no
+ * mark is active, the arena is suspended or it was disabled by defining
+ * preprocessor macro NOARENA. The caller must then use the heap.
+ */
+typedef struct arena {
+	struct chunk *first;	/* first chunk, NULL until first allocation */
+	struct chunk *current;	/* chunk from which is allocated */
+	int level;				/* number of active marks */
+	int suspended;			/* if > 0 do not allocate from the arena */
+
+	void *(*alloc)(size_t size);		/* allocate memory */
+	bool (*owns)(const void *ptr);		/* was ptr allocated from the arena */
+	ArenaMark (*mark)(void);			/* start a new region */
+	void (*release)(ArenaMark mark);	/* free everything since mark */
+	void (*suspend)(void);				/* temporarily use the heap */
+	void (*resume)(void);				/* undo suspend */
+} Arena;
+
+extern Arena arena;
+
+#endif
@@ -0,0 +1,32 @@
+# bignum.x
+
+# Benchmark for integers which do not fit in a machine word. Compute a large
+# factorial by splitting the product in halves, so most multiplications
+# have operands of similar size where Karatsuba's method pays off, then
+# compute a large power of 3. Only the number of digits is printed.
+#
+# Run with: time exin bignum.x
+#
+
+def product(lo, hi)
+    int mid
+
+    if hi - lo < 8
+        int p = 1
+
+        while lo <= hi
+            p *= lo
+            lo += 1
+
+        return p
+
+    mid = (lo + hi) / 2
+
+    return product(lo, mid) * product(mid + 1, hi)
+
+
+str s = product(1, 20000)
+print s.len
+
+s = pow(3, 200000)
+print s.len
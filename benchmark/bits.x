@@ -0,0 +1,51 @@
+# bits.x
+
+# Benchmark for the bitwise operators. Count the bits which are set in a
+# range of numbers, once with division and modulo as was needed before the
+# bitwise operators existed, and once with & and >>.
+#
+# Run with: time exin bits.x
+#
+
+def popcount_arith(n)
+    int count = 0
+
+    while n > 0
+        count += n % 2
+        n /= 2
+
+    return count
+
+
+def popcount_bits(n)
+    int count = 0
+
+    while n
+        n &= n - 1
+        count += 1
+
+    return count
+
+
+def total_arith(n)
+    int i = 0, sum = 0
+
+    while i < n
+        sum += popcount_arith(i)
+        i += 1
+
+    return sum
+
+
+def total_bits(n)
+    int i = 0, sum = 0
+
+    while i < n
+        sum += popcount_bits(i)
+        i += 1
+
+    return sum
+
+
+print total_arith(40000)
+print total_bits(40000)
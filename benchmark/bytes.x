@@ -0,0 +1,67 @@
+# bytes.x
+
+# Benchmark for bytes. A buffer of n records of 8 bytes is built, every
+# record holds a 16 bit big-endian key and a checksum byte. Then all
+# records are decoded and checked. This is done once with a list of
+# numbers, where every item is an object, and once with bytes, where
+# reading and storing a byte does not create an object.
+#
+# Run with: time exin bytes.x
+#
+
+def records_list(n)
+    list buf
+    int i = 0, j, k, sum = 0
+
+    while i < n
+        buf.append(i >> 8 & 255)
+        buf.append(i & 255)
+        j = 2
+        while j < 7
+            buf.append((i + j) & 255)
+            j += 1
+        buf.append(0)
+        i += 1
+
+    i = 0
+    while i < n
+        j = i * 8
+        k = 0
+        while k < 7
+            buf[j + 7] ^= buf[j + k]
+            k += 1
+        sum += (buf[j] << 8 | buf[j + 1]) + buf[j + 7]
+        i += 1
+
+    return sum
+
+
+def records_bytes(n)
+    bytes buf
+    int i = 0, j, k, sum = 0
+
+    while i < n
+        buf.append(i >> 8 & 255)
+        buf.append(i & 255)
+        j = 2
+        while j < 7
+            buf.append((i + j) & 255)
+            j += 1
+        buf.append(0)
+        i += 1
+
+    i = 0
+    while i < n
+        j = i * 8
+        k = 0
+        while k < 7
+            buf[j + 7] ^= buf[j + k]
+            k += 1
+        sum += (buf[j] << 8 | buf[j + 1]) + buf[j + 7]
+        i += 1
+
+    return sum
+
+
+print records_list(2000)
+print records_bytes(2000)
@@ -0,0 +1,60 @@
+# deque.x
+
+# Benchmark for the deque. Numbers are processed first in first out, as in
+# a breadth-first search: every number taken from the front of the queue
+# adds up to two new numbers at the back. This is done once with a list,
+# using remove(0) and append(), and once with a deque, using popleft() and
+# append(). Finally all items of the deque are read by index.
+#
+# Run with: time exin deque.x
+#
+
+def queue_list(n)
+    list q = [1]
+    int x, count = 0
+
+    while q.len
+        x = q.remove(0)
+        count += 1
+        if 2 * x <= n
+            q.append(2 * x)
+        if 2 * x + 1 <= n
+            q.append(2 * x + 1)
+
+    return count
+
+
+def queue_deque(n)
+    deque q = [1]
+    int x, count = 0
+
+    while q.len
+        x = q.popleft()
+        count += 1
+        if 2 * x <= n
+            q.append(2 * x)
+        if 2 * x + 1 <= n
+            q.append(2 * x + 1)
+
+    return count
+
+
+def index_deque(n)
+    deque q
+    int i = 0, sum = 0
+
+    while i < n
+        q.appendleft(i)
+        i += 1
+
+    i = 0
+    while i < n
+        sum += q[i]
+        i += 1
+
+    return sum
+
+
+print queue_list(10000)
+print queue_deque(10000)
+print index_deque(100000)
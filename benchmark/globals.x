@@ -0,0 +1,47 @@
+# globals.x
+
+# Benchmark for reading global variables from within a function. Every
+# global is first searched in the list with local variables and then in
+# the list with global variables. The many globals make this list long.
+#
+# Run with: time exin globals.x
+#
+
+int a0, a1, a2, a3, a4, a5, a6, a7, a8, a9
+int b0, b1, b2, b3, b4, b5, b6, b7, b8, b9
+int c0, c1, c2, c3, c4, c5, c6, c7, c8, c9
+
+int width = 3
+int height = 4
+int depth = 5
+int scale = 2
+
+
+def volume(n)
+    int i = 0
+    int sum = 0
+
+    while i < n
+        sum += width * height * depth * scale
+        i += 1
+
+    return sum
+
+
+# every call starts a new local scope, which must not discard the
+# cached lookups of the globals
+#
+def area()
+    return width * height * scale
+
+
+print volume(1000000)
+
+int k = 0
+int total = 0
+
+while k < 200000
+    total += area()
+    k += 1
+
+print total
@@ -0,0 +1,51 @@
+# guard.x
+
+# Benchmark for loops which are guarded by 'and' / 'or' conditions, like
+# function strip() in examples/split.x. Thanks to short-circuit evaluation
+# the right operand of 'and' and 'or' is only evaluated when needed, so the
+# guard also protects against indexing beyond the end of a string.
+#
+# Run with: time exin guard.x
+#
+
+# Remove leading spaces and tabs from a string
+#
+def strip(s)
+    int i = 0
+
+    while i < s.len and (s[i] == ' ' or s[i] == '\t')
+        i += 1
+
+    return s[i:]
+
+
+# Expensive check which is only called when the cheap check fails
+#
+def slow_is_blank(c)
+    str blanks = " \t"
+
+    return c in blanks
+
+
+# Count the number of leading blanks, the expensive check is a fallback
+#
+def count_blanks(s)
+    int i = 0
+
+    while i < s.len and (s[i] == ' ' or slow_is_blank(s[i]))
+        i += 1
+
+    return i
+
+
+str line = "                            word"
+str stripped
+int n = 0
+int total = 0
+
+while n < 20000
+    stripped = strip(line)
+    total += count_blanks(line)
+    n += 1
+
+print stripped, total
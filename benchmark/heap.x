@@ -0,0 +1,69 @@
+# heap.x
+
+# Benchmark for the heap. Random numbers are queued and then taken out
+# smallest first, once with a list which is kept sorted by inserting every
+# number at its place, and once with a heap. Finally the 10 largest of a
+# much longer series of numbers are selected with a heap of size 10.
+#
+# Run with: time exin heap.x
+#
+
+def queue_list(n)
+    list l
+    int i = 0, lo, hi, mid
+    float x, check = 0
+
+    seed(1)
+    while i < n
+        x = random()
+        lo = 0
+        hi = l.len
+        while lo < hi
+            mid = (lo + hi) / 2
+            if l[mid] < x
+                lo = mid + 1
+            else
+                hi = mid
+        l.insert(lo, x)
+        i += 1
+
+    while l.len
+        check = check * 0.5 + l.remove(0)
+
+    return check
+
+
+def queue_heap(n)
+    heap h
+    int i = 0
+    float check = 0
+
+    seed(1)
+    while i < n
+        h.push(random())
+        i += 1
+
+    while h.len
+        check = check * 0.5 + h.pop()
+
+    return check
+
+
+def top(n, k)
+    heap h
+    int i = 0
+
+    seed(2)
+    while i < n
+        if h.len < k
+            h.push(randint(0, 1000000000))
+        else
+            h.pushpop(randint(0, 1000000000))
+        i += 1
+
+    return h.pop()
+
+
+print queue_list(3000)
+print queue_heap(3000)
+print top(200000, 10)
@@ -0,0 +1,45 @@
+# math.x
+
+# Benchmark for the math builtins. Function power() is the interpreted
+# version of pow() from examples/power.x. Compare the time of both loops
+# by commenting out one of the print statements. With --emit-c the math
+# builtins on int and float variables become direct calls of C functions.
+#
+# Run with: time exin math.x
+#
+
+def power(b, e)
+    float x = b
+
+    if e == 0
+        return 1
+    while e > 1
+        x *= b
+        e -= 1
+    return x
+
+
+def interpreted(n)
+    int i = 0
+    float sum = 0
+
+    while i < n
+        sum += power(1.0001, 20)
+        i += 1
+
+    return sum
+
+
+def builtin(n)
+    int i = 0
+    float sum = 0
+
+    while i < n
+        sum += pow(1.0001, 20)
+        i += 1
+
+    return sum
+
+
+print interpreted(50000)
+print builtin(50000)
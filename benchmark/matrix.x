@@ -0,0 +1,69 @@
+# matrix.x
+
+# Benchmark for the matrix. Two square matrices with random elements are
+# multiplied, once stored as lists of lists using a triple loop and once
+# stored as matrices using dot(). Matrix multiplication is O(n^3), so the
+# lists are much smaller. The sum of the elements of the product is printed.
+#
+# Run with: time exin matrix.x
+#
+
+def random_lists(n)
+    list m, row
+    int i = 0, j
+
+    while i < n
+        row = []
+        j = 0
+        while j < n
+            row.append(random())
+            j += 1
+        m.append(row)
+        i += 1
+
+    return m
+
+
+def multiply_lists(n)
+    list a = random_lists(n), b = random_lists(n), c, row
+    int i = 0, j, k
+    float s
+
+    while i < n
+        row = []
+        j = 0
+        while j < n
+            s = 0
+            k = 0
+            while k < n
+                s += a[i][k] * b[k][j]
+                k += 1
+            row.append(s)
+            j += 1
+        c.append(row)
+        i += 1
+
+    s = 0
+    for row in c
+        for x in row
+            s += x
+    return s
+
+
+def multiply_matrices(n)
+    matrix a = randlist(n * n), b = randlist(n * n), c
+    float s = 0
+
+    a = a.reshape(n, n)
+    b = b.reshape(n, n)
+    c = a.dot(b)
+
+    for row in c
+        for x in row
+            s += x
+    return s
+
+
+seed(1)
+print multiply_lists(60)
+print multiply_matrices(1000)
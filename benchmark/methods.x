@@ -0,0 +1,27 @@
+# methods.x
+
+# Benchmark for method calls. Every method call searches the method in the
+# method table of the objects type.
+#
+# Run with: time exin methods.x
+#
+
+def churn(n)
+    int i = 0
+    int total = 0
+    list l = []
+    str s = "method"
+
+    while i < n
+        l.append(i)
+        l.insert(0, i)
+        total += l.len + s.len
+        l.remove(0)
+        if l.len > 100
+            l.remove(-1)
+        i += 1
+
+    return total
+
+
+print churn(300000)
@@ -0,0 +1,43 @@
+# numeric.x
+
+# Benchmark for arithmetic on declared int and float variables. Compare
+# the interpreter with the program translated to C:
+#
+# Run with: time exin numeric.x
+#      and: exin --emit-c numeric.x > numeric.c
+#           (compile numeric.c with all sources except main.c)
+#           time ./numeric
+#
+
+# Sum of the digits of all numbers below n
+#
+def digitsum(n)
+    int i, d, sum = 0
+
+    i = 1
+    while i < n
+        d = i
+        while d
+            sum += d % 10
+            d /= 10
+        i += 1
+
+    return sum
+
+
+# Approximate pi using the Leibniz series
+#
+def leibniz(terms)
+    int k = 0
+    float pi = 0.0, sign = 1.0
+
+    while k < terms
+        pi += sign / (2 * k + 1)
+        sign = -sign
+        k += 1
+
+    return 4 * pi
+
+
+print digitsum(200000)
+print leibniz(200000)
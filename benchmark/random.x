@@ -0,0 +1,49 @@
+# random.x
+
+# Benchmark for the random builtins. Estimate pi by drawing random points
+# in the unit square and counting how many fall inside the quarter circle.
+# Function lcg() is a random generator written in EXIN, as used before the
+# random builtins existed.
+#
+# Run with: time exin random.x
+#
+
+int state = 12345
+
+
+def lcg()
+    state = (state * 1103515245 + 12345) % 2147483648
+    return state / 2147483648.0
+
+
+def pi_lcg(n)
+    int i = 0, inside = 0
+    float x, y
+
+    while i < n
+        x = lcg()
+        y = lcg()
+        if x * x + y * y < 1
+            inside += 1
+        i += 1
+
+    return 4.0 * inside / n
+
+
+def pi_random(n)
+    int i = 0, inside = 0
+    float x, y
+
+    seed(12345)
+    while i < n
+        x = random()
+        y = random()
+        if x * x + y * y < 1
+            inside += 1
+        i += 1
+
+    return 4.0 * inside / n
+
+
+print pi_lcg(100000)
+print pi_random(100000)
@@ -0,0 +1,82 @@
+# regexp.x
+
+# Benchmark for regular expressions. From a log of n lines the lines with
+# an error code (the word ERROR followed by a space and 3 digits) are
+# counted. This is done once with a loop over the characters of every
+# line, and once with builtin search() which matches the characters in C
+# with a cached automaton. Then the error codes are counted with
+# findall(). Finally findall() searches a|a.*b in a string of n a's, where
+# looking for a longer match reads on to the end of the string every time.
+#
+# Run with: time exin regexp.x
+#
+
+def make_log(n)
+    deque log
+    list level = ["INFO", "DEBUG", "WARNING", "ERROR"]
+    int i = 0
+
+    while i < n
+        log.append("2020-05-17 12:00:00 " + level[i % 4] + " " + i % 1000 + " request handled by worker")
+        i += 1
+
+    return log
+
+
+def is_digit(c)
+    return c >= '0' and c <= '9'
+
+
+def count_loop(log)
+    int count = 0, i, len
+    str line
+
+    for line in log
+        len = line.len
+        i = 0
+        while i + 8 < len
+            if line[i] == 'E' and line[i:i + 6] == "ERROR "
+                if is_digit(line[i + 6]) and is_digit(line[i + 7]) and is_digit(line[i + 8])
+                    count += 1
+                    break
+            i += 1
+
+    return count
+
+
+def count_search(log)
+    int count = 0
+    str line
+
+    for line in log
+        if search("ERROR \\d\\d\\d", line) >= 0
+            count += 1
+
+    return count
+
+
+def codes(log)
+    int count = 0
+    str line
+
+    for line in log
+        count += findall("ERROR \\d{3}", line).len
+
+    return count
+
+
+def longest_first(n)
+    str s = "a"
+
+    while s.len < n
+        s += s
+
+    return findall("a|a.*b", s[0:n]).len
+
+
+deque log = make_log(20000)
+
+print count_loop(log)
+print count_search(log)
+print codes(log)
+print longest_first(100000)
@@ -0,0 +1,27 @@
+# scanner.x
+
+# Benchmark for the scanner. The interpreter reads the source code of the
+# loop body again in every iteration, so a long body with short operations
+# spends most of its time reading characters and tokens.
+#
+# Run with: time exin scanner.x
+#
+
+def tokens(n)
+    int i = 0
+    int a = 1
+    int b = 2
+    int c = 3
+
+    while i < n
+        a = ( b + c ) - ( c - b ) + ( a * 1 )  # comment is skipped
+        b = ( a + c ) - ( a - c ) - ( b * 1 )  # comment is skipped
+        c = ( a + b ) - ( a + b ) + ( c * 1 )  # comment is skipped
+        a = a % 1000
+        b = b % 1000
+        i += 1
+
+    return a + b + c
+
+
+print tokens(300000)
@@ -0,0 +1,39 @@
+# slice.x
+
+# Benchmark for list slices. A slice uses the listnodes of the list it was
+# taken from, so recursively passing the rest of a list via l[1:] does not
+# copy the list every time. The nodes are only copied when a list which
+# shares them is changed, as is done once at the end.
+#
+# Run with: time exin slice.x
+#
+
+def total(l)
+    if l.len == 0
+        return 0
+    return l[0] + total(l[1:])
+
+
+def tails(l, n)
+    int count = 0
+
+    while n
+        count += l[n:].len
+        n -= 1
+
+    return count
+
+
+list l, t
+int i = 0
+
+while i < 2000
+    l.append(i)
+    i += 1
+
+print total(l)
+print tails(l, 1000)
+
+t = l[1000:]
+t[0] = -1
+print l[1000], t[0]
@@ -0,0 +1,629 @@
+/* bignum.c
+ *
+ * Arbitrary precision integers
+ *
+ * An integer object whose value does not fit in an int_t keeps its value
+ * in a bignum (see number.c). Bignums are never modified after they have
+ * been created; every operation returns a new bignum which the caller must
+ * release via bignum_free().
+ *
+ * A bignum is stored as a sign and a magnitude. The mag_...() functions
+ * work on magnitudes only, being arrays of digits in base 2^32.
+ *
+ * Multiplication uses the schoolbook method for small numbers. When both
+ * numbers have at least KARATSUBA_CUTOFF digits Karatsuba's method is used,
+ * which replaces the four half size multiplications of the schoolbook method
+ * by three. Multiplying two n-digit numbers then takes O(n^1.585) instead of
+ * O(n^2) steps.
+ *
+ * Division is algorithm D from Knuth, The Art of Computer Programming,
+ * Vol. 2, section 4.3.1. Conversion to decimal repeatedly divides by 10^9,
+ * so every pass over the number produces 9 decimal digits instead of 1.
+ *
+ * 2020	K.W.E. de Lange
+ */
+#include <assert.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "bignum.h"
+#include "error.h"
+
+typedef uint64_t twodigit_t;
+
+#define DIGIT_BITS	32
+#define DIGIT_BASE	((twodigit_t)1 << DIGIT_BITS)
+
+#define DECIMAL_BASE	1000000000	/* largest power of 10 which fits in a digit */
+#define DECIMAL_DIGITS	9
+
+#define KARATSUBA_CUTOFF	40	/* see benchmark/bignum.x */
+
+
+/* Allocate a bignum with room for 'size' digits. The digits are not
+ * initialized.
+ */
+static Bignum *alloc(size_t size)
+{
+	Bignum *a;
+
+	if ((a = malloc(sizeof(Bignum) + (size ? size : 1) * sizeof(digit_t))) == NULL)
+		error(OutOfMemoryError);
+
+	a->negative = false;
+	a->size = size;
+
+	return a;
+}
+
+
+/* Remove leading zero digits.
+ */
+static Bignum *normalize(Bignum *a)
+{
+	while (a->size > 0 && a->digit[a->size - 1] == 0)
+		a->size--;
+
+	if (a->size == 0)
+		a->negative = false;
+
+	return a;
+}
+
+
+/* return   -1, 0 or 1 if magnitude a is less than, equal to or greater
+ *          than magnitude b
+ */
+static int mag_compare(const digit_t *a, size_t na, const digit_t *b, size_t nb)
+{
+	while (na > 0 && a[na - 1] == 0)
+		na--;
+	while (nb > 0 && b[nb - 1] == 0)
+		nb--;
+
+	if (na != nb)
+		return na < nb ? -1 : 1;
+
+	while (na-- > 0)
+		if (a[na] != b[na])
+			return a[na] < b[na] ? -1 : 1;
+
+	return 0;
+}
+
+
+/* r += a, where r has nr digits and na <= nr. The result must fit in nr
+ * digits.
+ */
+static void mag_add_to(digit_t *r, size_t nr, const digit_t *a, size_t na)
+{
+	twodigit_t carry = 0;
+	size_t i;
+
+	for (i = 0; i < na; i++) {
+		carry += (twodigit_t)r[i] + a[i];
+		r[i] = (digit_t)carry;
+		carry >>= DIGIT_BITS;
+	}
+	for (; carry && i < nr; i++) {
+		carry += r[i];
+		r[i] = (digit_t)carry;
+		carry >>= DIGIT_BITS;
+	}
+}
+
+
+/* r -= a, where r has nr digits and na <= nr. R must not be less than a.
+ */
+static void mag_sub_from(digit_t *r, size_t nr, const digit_t *a, size_t na)
+{
+	twodigit_t borrow = 0, t;
+	size_t i;
+
+	for (i = 0; i < na; i++) {
+		t = (twodigit_t)r[i] - a[i] - borrow;
+		r[i] = (digit_t)t;
+		borrow = (t >> DIGIT_BITS) & 1;
+	}
+	for (; borrow && i < nr; i++) {
+		t = (twodigit_t)r[i] - borrow;
+		r[i] = (digit_t)t;
+		borrow = (t >> DIGIT_BITS) & 1;
+	}
+}
+
+
+/* r = a * b via the schoolbook method. R has na + nb digits.
+ */
+static void mag_mul_school(digit_t *r, const digit_t *a, size_t na, const digit_t *b, size_t nb)
+{
+	twodigit_t carry;
+
+	memset(r, 0, (na + nb) * sizeof(digit_t));
+
+	for (size_t i = 0; i < na; i++) {
+		if (a[i] == 0)
+			continue;
+		carry = 0;
+		for (size_t j = 0; j < nb; j++) {
+			carry += (twodigit_t)a[i] * b[j] + r[i + j];
+			r[i + j] = (digit_t)carry;
+			carry >>= DIGIT_BITS;
+		}
+		r[i + nb] = (digit_t)carry;
+	}
+}
+
+
+/* r = a * b. R has na + nb digits.
+ *
+ * Karatsuba: split a and b at m digits in a1 * B^m + a0 and b1 * B^m + b0.
+ * Then a * b = z2 * B^2m + z1 * B^m + z0, with z2 = a1 * b1, z0 = a0 * b0
+ * and z1 = (a0 + a1) * (b0 + b1) - z2 - z0.
+ */
+static void mag_mul(digit_t *r, const digit_t *a, size_t na, const digit_t *b, size_t nb)
+{
+	const digit_t *swap;
+	digit_t *s, *t, *z1;
+	size_t m, n, ns, nt;
+
+	if (na < nb) {
+		swap = a, a = b, b = swap;
+		n = na, na = nb, nb = n;
+	}
+
+	if (nb < KARATSUBA_CUTOFF) {
+		mag_mul_school(r, a, na, b, nb);
+		return;
+	}
+
+	if (na >= 2 * nb) {  /* unbalanced, multiply b by slices of a of nb digits */
+		if ((t = malloc(2 * nb * sizeof(digit_t))) == NULL)
+			error(OutOfMemoryError);
+
+		memset(r, 0, (na + nb) * sizeof(digit_t));
+		for (size_t i = 0; i < na; i += nb) {
+			n = na - i < nb ? na - i : nb;
+			mag_mul(t, a + i, n, b, nb);
+			mag_add_to(r + i, na + nb - i, t, n + nb);
+		}
+		free(t);
+		return;
+	}
+
+	m = na / 2;  /* as nb > na / 2 both a1 and b1 have at least one digit */
+	ns = na - m + 1;
+	nt = (nb - m > m ? nb - m : m) + 1;
+
+	if ((s = calloc(2 * (ns + nt), sizeof(digit_t))) == NULL)
+		error(OutOfMemoryError);
+
+	t = s + ns;
+	z1 = t + nt;
+
+	mag_mul(r, a, m, b, m);  /* z0 */
+	mag_mul(r + 2 * m, a + m, na - m, b + m, nb - m);  /* z2 */
+
+	mag_add_to(s, ns, a, m);
+	mag_add_to(s, ns, a + m, na - m);
+	mag_add_to(t, nt, b, m);
+	mag_add_to(t, nt, b + m, nb - m);
+
+	mag_mul(z1, s, ns, t, nt);
+	mag_sub_from(z1, ns + nt, r, 2 * m);
+	mag_sub_from(z1, ns + nt, r + 2 * m, na + nb - 2 * m);
+
+	for (n = ns + nt; n > 0 && z1[n - 1] == 0; n--)
+		;
+	mag_add_to(r + m, na + nb - m, z1, n);
+
+	free(s);
+}
+
+
+/* q = a / b and r = a % b. Q has na - nb + 1 digits and r has nb digits.
+ * Requires na >= nb and a most significant digit of b which is not 0.
+ */
+static void mag_divmod(digit_t *q, digit_t *r, const digit_t *a, size_t na, const digit_t *b, size_t nb)
+{
+	twodigit_t num, qhat, rhat, p, carry;
+	int64_t t, k;
+	digit_t *un, *vn;
+	size_t i, j;
+	int s;
+
+	assert(na >= nb && nb > 0 && b[nb - 1] != 0);
+
+	if (nb == 1) {  /* short division */
+		for (i = na, carry = 0; i-- > 0; ) {
+			carry = (carry << DIGIT_BITS) | a[i];
+			q[i] = (digit_t)(carry / b[0]);
+			carry %= b[0];
+		}
+		r[0] = (digit_t)carry;
+		return;
+	}
+
+	if ((un = malloc((na + 1 + nb) * sizeof(digit_t))) == NULL)
+		error(OutOfMemoryError);
+
+	vn = un + na + 1;
+
+	/* shift a and b left until the top bit of b is set */
+	for (s = 0; (b[nb - 1] << s & 0x80000000) == 0; s++)
+		;
+	for (i = nb - 1; i > 0; i--)
+		vn[i] = (b[i] << s) | (digit_t)((twodigit_t)b[i - 1] >> (DIGIT_BITS - s));
+	vn[0] = b[0] << s;
+
+	un[na] = (digit_t)((twodigit_t)a[na - 1] >> (DIGIT_BITS - s));
+	for (i = na - 1; i > 0; i--)
+		un[i] = (a[i] << s) | (digit_t)((twodigit_t)a[i - 1] >> (DIGIT_BITS - s));
+	un[0] = a[0] << s;
+
+	for (j = na - nb + 1; j-- > 0; ) {
+		/* estimate the quotient digit, it is at most 2 too high */
+		num = ((twodigit_t)un[j + nb] << DIGIT_BITS) | un[j + nb - 1];
+		qhat = num / vn[nb - 1];
+		rhat = num % vn[nb - 1];
+		while (qhat >= DIGIT_BASE || qhat * vn[nb - 2] > ((rhat << DIGIT_BITS) | un[j + nb - 2])) {
+			qhat--;
+			rhat += vn[nb - 1];
+			if (rhat >= DIGIT_BASE)
+				break;
+		}
+
+		/* multiply and subtract */
+		for (i = 0, k = 0; i < nb; i++) {
+			p = qhat * vn[i];
+			t = (int64_t)un[i + j] - k - (int64_t)(p & 0xFFFFFFFF);
+			un[i + j] = (digit_t)t;
+			k = (int64_t)(p >> DIGIT_BITS) - (t >> DIGIT_BITS);
+		}
+		t = (int64_t)un[j + nb] - k;
+		un[j + nb] = (digit_t)t;
+
+		q[j] = (digit_t)qhat;
+
+		if (t < 0) {  /* subtracted too much, add back */
+			q[j]--;
+			for (i = 0, carry = 0; i < nb; i++) {
+				carry += (twodigit_t)un[i + j] + vn[i];
+				un[i + j] = (digit_t)carry;
+				carry >>= DIGIT_BITS;
+			}
+			un[j + nb] += (digit_t)carry;
+		}
+	}
+
+	/* undo the shift for the remainder */
+	for (i = 0; i < nb - 1; i++)
+		r[i] = (un[i] >> s) | (digit_t)((twodigit_t)un[i + 1] << (DIGIT_BITS - s));
+	r[nb - 1] = un[nb - 1] >> s;
+
+	free(un);
+}
+
+
+/* Create a bignum with value i.
+ */
+Bignum *bignum_from_int(int_t i)
+{
+	unsigned long long m;
+	Bignum *a;
+	size_t n;
+
+	a = alloc(sizeof m / sizeof(digit_t));
+
+	m = i < 0 ? 0ULL - (unsigned long long)i : (unsigned long long)i;
+
+	for (n = 0; m; m >>= DIGIT_BITS)
+		a->digit[n++] = (digit_t)m;
+
+	a->size = n;
+	a->negative = i < 0;
+
+	return a;
+}
+
+
+/* Create a bignum from a string of decimal digits, optionally preceded by
+ * a sign.
+ *
+ * return   new bignum, or NULL if s is not an integer
+ */
+Bignum *bignum_from_str(const char *s)
+{
+	twodigit_t carry, multiplier;
+	bool negative = false;
+	size_t len, n;
+	Bignum *a;
+
+	if (*s == '-' || *s == '+')
+		negative = (*s++ == '-');
+
+	len = strspn(s, "0123456789");
+
+	if (len == 0 || s[len] != '\0')
+		return NULL;
+
+	a = alloc(len / DECIMAL_DIGITS + 1);
+	a->size = 0;
+
+	/* a = a * 10^n + the next n digits, for groups of 9 digits except the
+	 * first which contains the remainder */
+	for (n = len % DECIMAL_DIGITS ? len % DECIMAL_DIGITS : DECIMAL_DIGITS; len > 0; n = DECIMAL_DIGITS) {
+		len -= n;
+		for (carry = 0, multiplier = 1; n > 0; n--, s++) {
+			carry = carry * 10 + (twodigit_t)(*s - '0');
+			multiplier *= 10;
+		}
+		for (size_t i = 0; i < a->size; i++) {
+			carry += (twodigit_t)a->digit[i] * multiplier;
+			a->digit[i] = (digit_t)carry;
+			carry >>= DIGIT_BITS;
+		}
+		if (carry)
+			a->digit[a->size++] = (digit_t)carry;
+	}
+
+	a->negative = negative;
+
+	return normalize(a);
+}
+
+
+Bignum *bignum_copy(const Bignum *a)
+{
+	Bignum *b = alloc(a->size);
+
+	memcpy(b->digit, a->digit, a->size * sizeof(digit_t));
+	b->negative = a->negative;
+
+	return b;
+}
+
+
+void bignum_free(Bignum *a)
+{
+	free(a);
+}
+
+
+/* Convert bignum a to an int_t.
+ *
+ * return   false if a does not fit in an int_t, else true and the value
+ *          in *i
+ */
+bool bignum_to_int(const Bignum *a, int_t *i)
+{
+	unsigned long long m = 0;
+	unsigned long long max = ((unsigned long long)1 << (sizeof(int_t) * CHAR_BIT - 1)) - 1;
+
+	if (a->size * sizeof(digit_t) > sizeof m)
+		return false;
+
+	for (size_t n = a->size; n-- > 0; )
+		m = (m << DIGIT_BITS) | a->digit[n];
+
+	if (m > max + a->negative)
+		return false;
+
+	*i = a->negative ? -(int_t)(m - 1) - 1 : (int_t)m;
+
+	return true;
+}
+
+
+float_t bignum_to_float(const Bignum *a)
+{
+	float_t f = 0;
+
+	for (size_t n = a->size; n-- > 0; )
+		f = f * (float_t)DIGIT_BASE + a->digit[n];
+
+	return a->negative ? -f : f;
+}
+
+
+/* Convert bignum a to a string of decimal digits.
+ *
+ * return   string, which the caller must free
+ */
+char *bignum_to_str(const Bignum *a)
+{
+	size_t n = a->size, chunks = 0;
+	unsigned long *chunk;
+	twodigit_t carry;
+	digit_t *m;
+	char *s, *p;
+
+	/* a digit is at most 9.64 decimal digits, so 10 / 9 chunks per digit */
+	if ((m = malloc((n + 1) * sizeof(digit_t))) == NULL || \
+		(chunk = malloc((n * 10 / 9 + 2) * sizeof(unsigned long))) == NULL)
+		error(OutOfMemoryError);
+
+	memcpy(m, a->digit, n * sizeof(digit_t));
+
+	while (n > 0) {  /* m /= 10^9, the remainder are the next 9 decimal digits */
+		carry = 0;
+		for (size_t i = n; i-- > 0; ) {
+			carry = (carry << DIGIT_BITS) | m[i];
+			m[i] = (digit_t)(carry / DECIMAL_BASE);
+			carry %= DECIMAL_BASE;
+		}
+		chunk[chunks++] = (unsigned long)carry;
+		while (n > 0 && m[n - 1] == 0)
+			n--;
+	}
+
+	if ((s = malloc(chunks * DECIMAL_DIGITS + 2)) == NULL)
+		error(OutOfMemoryError);
+
+	p = s;
+
+	if (a->negative)
+		*p++ = '-';
+
+	if (chunks == 0)
+		strcpy(p, "0");
+	else {
+		p += sprintf(p, "%lu", chunk[--chunks]);
+		while (chunks > 0)
+			p += sprintf(p, "%09lu", chunk[--chunks]);
+	}
+
+	free(chunk);
+	free(m);
+
+	return s;
+}
+
+
+/* return   -1, 0 or 1 if a is less than, equal to or greater than b
+ */
+int bignum_compare(const Bignum *a, const Bignum *b)
+{
+	int c;
+
+	if (a->negative != b->negative)
+		return a->negative ? -1 : 1;
+
+	c = mag_compare(a->digit, a->size, b->digit, b->size);
+
+	return a->negative ? -c : c;
+}
+
+
+/* return   a + b, or a - b if negate is true
+ */
+static Bignum *addsub(const Bignum *a, const Bignum *b, bool negate)
+{
+	bool bnegative = (b->negative != negate);
+	const Bignum *x, *y;
+	Bignum *r;
+	int c;
+
+	if (a->negative == bnegative) {  /* add the magnitudes */
+		x = a->size >= b->size ? a : b;
+		y = x == a ? b : a;
+		r = alloc(x->size + 1);
+		memcpy(r->digit, x->digit, x->size * sizeof(digit_t));
+		r->digit[x->size] = 0;
+		mag_add_to(r->digit, r->size, y->digit, y->size);
+		r->negative = a->negative;
+	} else {  /* subtract the smallest magnitude from the largest */
+		c = mag_compare(a->digit, a->size, b->digit, b->size);
+		x = c >= 0 ? a : b;
+		y = x == a ? b : a;
+		r = alloc(x->size);
+		memcpy(r->digit, x->digit, x->size * sizeof(digit_t));
+		mag_sub_from(r->digit, r->size, y->digit, y->size);
+		r->negative = c >= 0 ? a->negative : bnegative;
+	}
+	return normalize(r);
+}
+
+
+Bignum *bignum_add(const Bignum *a, const Bignum *b)
+{
+	return addsub(a, b, false);
+}
+
+
+Bignum *bignum_sub(const Bignum *a, const Bignum *b)
+{
+	return addsub(a, b, true);
+}
+
+
+Bignum *bignum_mul(const Bignum *a, const Bignum *b)
+{
+	Bignum *r;
+
+	if (a->size == 0 || b->size == 0)
+		return alloc(0);
+
+	r = alloc(a->size + b->size);
+	mag_mul(r->digit, a->digit, a->size, b->digit, b->size);
+	r->negative = (a->negative != b->negative);
+
+	return normalize(r);
+}
+
+
+/* q = a / b and r = a % b. Like in C the quotient is truncated towards zero
+ * and the remainder has the sign of a. B may not be 0.
+ */
+static void divmod(const Bignum *a, const Bignum *b, Bignum **q, Bignum **r)
+{
+	assert(b->size > 0);
+
+	if (mag_compare(a->digit, a->size, b->digit, b->size) < 0) {
+		*q = alloc(0);
+		*r = bignum_copy(a);
+		return;
+	}
+
+	*q = alloc(a->size - b->size + 1);
+	*r = alloc(b->size);
+
+	mag_divmod((*q)->digit, (*r)->digit, a->digit, a->size, b->digit, b->size);
+
+	(*q)->negative = (a->negative != b->negative);
+	(*r)->negative = a->negative;
+
+	normalize(*q);
+	normalize(*r);
+}
+
+
+Bignum *bignum_div(const Bignum *a, const Bignum *b)
+{
+	Bignum *q, *r;
+
+	divmod(a, b, &q, &r);
+	bignum_free(r);
+
+	return q;
+}
+
+
+Bignum *bignum_mod(const Bignum *a, const Bignum *b)
+{
+	Bignum *q, *r;
+
+	divmod(a, b, &q, &r);
+	bignum_free(q);
+
+	return r;
+}
+
+
+/* return   a to the power n, via exponentiation by squaring
+ */
+Bignum *bignum_pow(const Bignum *a, unsigned long n)
+{
+	Bignum *r, *x, *t;
+
+	r = bignum_from_int(1);
+	x = bignum_copy(a);
+
+	while (n) {
+		if (n & 1) {
+			t = bignum_mul(r, x);
+			bignum_free(r);
+			r = t;
+		}
+		if ((n >>= 1) != 0) {
+			t = bignum_mul(x, x);
+			bignum_free(x);
+			x = t;
+		}
+	}
+	bignum_free(x);
+
+	return r;
+}
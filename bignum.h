@@ -0,0 +1,44 @@
+/* bignum.h
+ *
+ * 2020	K.W.E. de Lange
+ */
+#ifndef _BIGNUM_
+#define _BIGNUM_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "config.h"
+
+typedef uint32_t digit_t;
+
+/* An integer of arbitrary size. The magnitude is stored as an array of
+ * digits in base 2^32, least significant digit first, without leading
+ * zero digits. Zero has size 0 and is never negative.
+ */
+typedef struct bignum {
+	bool negative;
+	size_t size;		/* number of digits in use */
+	digit_t digit[];
+} Bignum;
+
+extern Bignum *bignum_from_int(int_t i);
+extern Bignum *bignum_from_str(const char *s);
+extern Bignum *bignum_copy(const Bignum *a);
+extern void bignum_free(Bignum *a);
+
+extern bool bignum_to_int(const Bignum *a, int_t *i);
+extern float_t bignum_to_float(const Bignum *a);
+extern char *bignum_to_str(const Bignum *a);
+
+extern int bignum_compare(const Bignum *a, const Bignum *b);
+
+extern Bignum *bignum_add(const Bignum *a, const Bignum *b);
+extern Bignum *bignum_sub(const Bignum *a, const Bignum *b);
+extern Bignum *bignum_mul(const Bignum *a, const Bignum *b);
+extern Bignum *bignum_div(const Bignum *a, const Bignum *b);
+extern Bignum *bignum_mod(const Bignum *a, const Bignum *b);
+extern Bignum *bignum_pow(const Bignum *a, unsigned long n);
+
+#endif
@@ -0,0 +1,363 @@
+/* bytes.c
+ *
+ * Bytes object operations
+ *
+ * See bytes.h for an explanation of how bytes objects are structured. A
+ * string ends at the first NUL character and indexing it creates a char
+ * object per character. Bytes hold binary data, and indexing and storing
+ * bytes does not create objects (see benchmark/bytes.x).
+ *
+ * 2020	K.W.E. de Lange
+ */
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "number.h"
+#include "object.h"
+#include "error.h"
+#include "bytes.h"
+
+
+/* Create a new empty bytes object.
+ */
+static BytesObject *bytes_alloc(void)
+{
+	BytesObject *b;
+
+	if ((b = calloc(1, sizeof(BytesObject))) == NULL)
+		error(OutOfMemoryError);
+
+	b->type = BYTES_T;
+	b->refcount = 0;
+
+	b->size = 0;
+	b->capacity = 0;
+	b->data = NULL;
+
+	return b;
+}
+
+
+static void bytes_free(BytesObject *b)
+{
+	free(b->data);
+	free(b);
+}
+
+
+/* Print bytes as b"...". Bytes which are not printable are shown as \xhh.
+ */
+static void bytes_print(BytesObject *b)
+{
+	printf("b\"");
+
+	for (size_t i = 0; i < b->size; i++)
+		if (isprint(b->data[i]) && b->data[i] != '"' && b->data[i] != '\\')
+			putchar(b->data[i]);
+		else
+			printf("\\x%02x", b->data[i]);
+
+	printf("\"");
+}
+
+
+/* Make room for n more bytes. The capacity is at least doubled, so appending
+ * bytes one by one takes amortized constant time.
+ */
+static void reserve(BytesObject *b, size_t n)
+{
+	unsigned char *data;
+	size_t capacity;
+
+	if (b->size + n <= b->capacity)
+		return;
+
+	capacity = b->capacity ? b->capacity * 2 : 16;
+
+	if (capacity < b->size + n)
+		capacity = b->size + n;
+
+	if ((data = realloc(b->data, capacity)) == NULL)
+		error(OutOfMemoryError);
+
+	b->data = data;
+	b->capacity = capacity;
+}
+
+
+/* Add n bytes from data at the end of a bytes object.
+ */
+static void extend(BytesObject *b, const unsigned char *data, size_t n)
+{
+	if (n == 0)
+		return;
+
+	reserve(b, n);
+	memmove(b->data + b->size, data, n);  /* data may be part of b */
+	b->size += n;
+}
+
+
+/* Convert a number to a byte.
+ */
+static unsigned char byte(int_t value)
+{
+	if (value < 0 || value > 255)
+		error(ValueError, "byte must be in range 0 to 255, not %ld", value);
+
+	return (unsigned char)value;
+}
+
+
+/* Retrieve a byte by index. A negative index counts back from the end.
+ *
+ * return   shared integer object, NULL if index is out of range
+ */
+static Object *bytes_item(BytesObject *b, int index)
+{
+	if (index < 0)
+		index += (int)b->size;
+
+	if (index < 0 || (size_t)index >= b->size)
+		return NULL;  /* IndexError: index out of range */
+
+	return inttype.shared(b->data[index]);
+}
+
+
+/* Store a byte by index. A negative index counts back from the end.
+ *
+ * return   false if index is out of range
+ */
+static bool bytes_store(BytesObject *b, int index, int_t value)
+{
+	if (index < 0)
+		index += (int)b->size;
+
+	if (index < 0 || (size_t)index >= b->size)
+		return false;  /* IndexError: index out of range */
+
+	b->data[index] = byte(value);
+
+	return true;
+}
+
+
+/* Create a new bytes object from a slice of an existing one.
+ *
+ * Start and end are automatically adjusted to the nearest possible values.
+ */
+static BytesObject *bytes_slice(BytesObject *b, int start, int end)
+{
+	BytesObject *slice;
+	int len = (int)b->size;
+
+	if (start < 0)
+		start += len;
+
+	if (end < 0)
+		end += len;
+
+	if (start < 0)
+		start = 0;
+
+	if (end >= len)
+		end = len;
+
+	slice = (BytesObject *)obj_alloc(BYTES_T);
+
+	if (start < end)
+		extend(slice, b->data + start, (size_t)(end - start));
+
+	return slice;
+}
+
+
+/* Create a new bytes object containing the bytes of op1 followed by those of op2.
+ */
+static BytesObject *bytes_concat(BytesObject *op1, BytesObject *op2)
+{
+	BytesObject *b = (BytesObject *)obj_alloc(BYTES_T);
+
+	reserve(b, op1->size + op2->size);
+	extend(b, op1->data, op1->size);
+	extend(b, op2->data, op2->size);
+
+	return b;
+}
+
+
+/* Add the contents of obj at the end of a bytes object. Obj can be a
+ * number (one byte), a string, a list of numbers or another bytes object.
+ */
+static void bytes_append(BytesObject *b, Object *obj)
+{
+	unsigned char c;
+
+	obj = isListNode(obj) ? obj_from_listnode(obj) : obj;
+
+	switch (TYPE(obj)) {
+		case CHAR_T:
+		case INT_T:
+			c = byte(obj_as_int(obj));
+			extend(b, &c, 1);
+			break;
+		case STR_T:
+			extend(b, (unsigned char *)obj_as_str(obj), strlen(obj_as_str(obj)));
+			break;
+		case BYTES_T:
+			reserve(b, ((BytesObject *)obj)->size);  /* first, as obj can be b */
+			extend(b, ((BytesObject *)obj)->data, ((BytesObject *)obj)->size);
+			break;
+		case LIST_T:
+			for (ListNode *node = ((ListObject *)obj)->head; node; node = list_next((ListObject *)obj, node)) {
+				if (!isInteger(node->obj))
+					error(TypeError, "cannot convert %s to byte", TYPENAME(node->obj));
+				c = byte(obj_as_int(node->obj));
+				extend(b, &c, 1);
+			}
+			break;
+		default:
+			error(TypeError, "cannot convert %s to bytes", TYPENAME(obj));
+	}
+}
+
+
+/* Fill a bytes object with the contents of a number, string, list of
+ * numbers or another bytes object.
+ */
+static BytesObject *bytes_set(BytesObject *dest, Object *src)
+{
+	if ((Object *)dest == src)
+		return dest;
+
+	dest->size = 0;
+	bytes_append(dest, src);
+
+	return dest;
+}
+
+
+static BytesObject *bytes_vset(BytesObject *b, va_list argp)
+{
+	return bytes_set(b, va_arg(argp, Object *));
+}
+
+
+static int_t size(BytesObject *b)
+{
+	return (int_t)b->size;
+}
+
+
+/* Search for a byte (a number), or for a sequence of bytes (a string or
+ * bytes object).
+ *
+ * return   index of the first occurrence, -1 if not found
+ */
+static int_t find(BytesObject *b, Object *obj)
+{
+	const unsigned char *needle = NULL, *p, *end;
+	size_t n = 0;
+	unsigned char c;
+
+	obj = isListNode(obj) ? obj_from_listnode(obj) : obj;
+
+	if (isInteger(obj)) {
+		c = byte(obj_as_int(obj));
+		needle = &c;
+		n = 1;
+	} else if (isString(obj)) {
+		needle = (unsigned char *)obj_as_str(obj);
+		n = strlen(obj_as_str(obj));
+	} else if (isBytes(obj)) {
+		needle = ((BytesObject *)obj)->data;
+		n = ((BytesObject *)obj)->size;
+	} else
+		error(TypeError, "cannot search for %s in bytes", TYPENAME(obj));
+
+	if (n == 0)
+		return 0;
+
+	if (n > b->size)
+		return -1;
+
+	end = b->data + b->size - n + 1;  /* last position where needle fits + 1 */
+
+	for (p = b->data; p < end && (p = memchr(p, needle[0], (size_t)(end - p))) != NULL; p++)
+		if (memcmp(p, needle, n) == 0)
+			return (int_t)(p - b->data);
+
+	return -1;
+}
+
+
+static bool equal(BytesObject *op1, BytesObject *op2)
+{
+	return op1->size == op2->size && (op1->size == 0 || memcmp(op1->data, op2->data, op1->size) == 0);
+}
+
+
+/* Method: bytes.append(object)
+ */
+static Object *method_append(Object *b, Object **argv)
+{
+	bytes_append((BytesObject *)b, argv[0]);
+	obj_decref(argv[0]);
+
+	return obj_alloc(NONE_T);
+}
+
+
+/* Method: bytes.find(object)
+ */
+static Object *method_find(Object *b, Object **argv)
+{
+	int_t index = find((BytesObject *)b, argv[0]);
+
+	obj_decref(argv[0]);
+
+	return obj_new_int(index);
+}
+
+
+/* Method: bytes.len
+ */
+static Object *method_len(Object *b, Object **argv)
+{
+	return inttype.shared(size((BytesObject *)b));
+}
+
+
+static Method bytesmethod[] = {
+	{"append", method_append, 1},
+	{"find", method_find, 1},
+	{"len", method_len, NOARGLIST},
+	{NULL}
+};
+
+static MethodTable bytesmethods = { .method = bytesmethod };
+
+
+/* Bytes object API.
+ */
+BytesType bytestype = {
+	.name = "bytes",
+	.alloc = (Object *(*)())bytes_alloc,
+	.free = (void (*)(Object *))bytes_free,
+	.print = (void (*)(Object *))bytes_print,
+	.set = (Object *(*)())bytes_set,
+	.vset = (Object *(*)(Object *, va_list))bytes_vset,
+	.methods = &bytesmethods,
+
+	.item = bytes_item,
+	.store = bytes_store,
+	.slice = bytes_slice,
+	.concat = bytes_concat,
+
+	.size = size,
+	.find = find,
+	.equal = equal
+	};
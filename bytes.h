@@ -0,0 +1,39 @@
+/* bytes.h
+ *
+ * A bytes object is a mutable sequence of bytes (values 0 to 255) kept in a
+ * contiguous array. Unlike a string it has an explicit size, so it can hold
+ * any binary data including NUL bytes. Indexing a bytes object returns the
+ * byte as a shared integer, so reading bytes never allocates an object.
+ *
+ * 2020	K.W.E. de Lange
+ */
+#ifndef _BYTES_
+#define _BYTES_
+
+#include <stdbool.h>
+
+#include "object.h"
+
+typedef struct bytesobject {
+	OBJ_HEAD;
+	size_t size;		/* number of bytes in use */
+	size_t capacity;	/* number of bytes allocated */
+	unsigned char *data;
+} BytesObject;
+
+typedef struct {
+	TYPE_HEAD;
+	Object *(*item)(BytesObject *b, int index);
+	bool (*store)(BytesObject *b, int index, int_t value);
+	BytesObject *(*slice)(BytesObject *b, int start, int end);
+	BytesObject *(*concat)(BytesObject *op1, BytesObject *op2);
+
+	/* raw versions for internal use, no result object is created */
+	int_t (*size)(BytesObject *b);
+	int_t (*find)(BytesObject *b, Object *obj);
+	bool (*equal)(BytesObject *op1, BytesObject *op2);
+} BytesType;
+
+extern BytesType bytestype;
+
+#endif
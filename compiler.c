@@ -0,0 +1,2351 @@
+/* compiler.c
+ *
+ * Translate a program to C.
+ *
+ * The translator reads the code with the same scanner as the interpreter,
+ * and its functions follow the structure of parser.c and expression.c.
+ * Instead of executing a statement it writes the C code which does the
+ * same, using the object operations from object.c. For the support
+ * functions the translated code needs see runtime.c. The C code is written
+ * to stdout. A native executable is made by compiling it together with all
+ * source files of the interpreter except main.c.
+ *
+ * The translation is done in two passes. The first pass reads all modules
+ * which are imported and collects the functions and the declared variables.
+ * The second pass translates every module to a C function m_<number>() and
+ * every EXIN function to a C function f_<name>().
+ *
+ * A variable which is always declared as int (or always as float), and is
+ * never used as function parameter or as loop variable in a for statement,
+ * always holds a number of this type. For a local variable its declaration
+ * must also precede every use in the same or an enclosing block, because
+ * until the declaration is executed the name refers to the global variable. It then becomes a C variable of type
+ * int_t (or float_t) instead of an object. Expressions on such numbers are
+ * translated to C expressions. All other values are objects.
+ *
+ * The type of many objects is also known while translating, for example
+ * for literals and for variables which are always declared with the same
+ * type (obj_assign() keeps the type of a variable). For these objects the
+ * operations of the type are called directly instead of via the obj_...
+ * functions which check the types of their operands. An operation which
+ * will always fail because of the types of its operands is reported as
+ * TypeError while translating.
+ *
+ * Limitations: a module which is imported must be specified as a string
+ * literal, as the modules are read when translating.
+ *
+ * 2020	K.W.E. de Lange
+ */
+#include <errno.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "compiler.h"
+#include "identifier.h"
+#include "position.h"
+#include "function.h"
+#include "module.h"
+#include "native.h"
+#include "reader.h"
+#include "strdup.h"
+#include "error.h"
+
+#define CODESIZE	1024	/* maximum length of the C code of an expression */
+
+
+/* How a value is represented in the C code.
+ */
+typedef enum { K_INT, K_FLOAT, K_OBJ } kind_t;
+
+
+typedef struct variable {
+	char *name;
+	char *cname;			/* name in the C code */
+	objecttype_t type;		/* type in the declaration */
+	kind_t kind;
+	bool declared;			/* appears in a declaration */
+	bool conflict;			/* declared with different types */
+	bool param;				/* is function parameter */
+	bool forvar;			/* is loop variable in a for statement */
+	bool typed;				/* always has the declared type */
+	bool shadow;			/* local which can be read before it is declared */
+	int level;				/* block level of the declaration while collecting, 0 if out of scope */
+	char *ref;				/* C code which refers to the object of the variable */
+	struct variable *next;
+} Variable;
+
+
+typedef struct function {
+	char *name;
+	PositionObject *pos;	/* IDENTIFIER of the function definition */
+	Variable *vars;			/* parameters and local variables */
+	Variable **param;		/* parameters in order of appearance */
+	int nparams;
+	bool returns;			/* contains return statement */
+	int level;				/* block level while collecting */
+	Variable *used;			/* names used while no local declaration was in scope */
+	struct buffer *code;
+	struct function *next;
+} Function;
+
+
+typedef struct unit {
+	Module *module;
+	int number;				/* translated to C function m_<number>() */
+	bool returns;			/* contains return statement */
+	struct buffer *code;
+	struct unit *next;
+} Unit;
+
+
+typedef struct buffer {
+	char *text;
+	size_t len;
+	size_t size;
+} Buffer;
+
+
+/* The value of an expression.
+ *
+ * For K_INT and K_FLOAT the C code is an expression of type int_t or float_t.
+ * For K_OBJ the C code is the name of a C variable which points to an object
+ * on the stack with temporary objects (see runtime.c).
+ */
+typedef struct {
+	kind_t kind;
+	objecttype_t type;	/* type of the value, UNDEFINED if not known */
+	bool stable;		/* code is a name or a constant */
+	Variable *var;		/* variable which code refers to, if K_INT or K_FLOAT */
+	char code[CODESIZE];
+} Expr;
+
+
+static Variable *globals = NULL;	/* global variables */
+static Function *functions = NULL;	/* all functions */
+static Unit *units = NULL;			/* all modules */
+
+static Function *current = NULL;	/* function being translated, NULL for module */
+static Buffer *out = NULL;			/* C code is written here */
+static int indent = 0;				/* indentation level of the C code */
+static int counter = 0;				/* to create unique names in the C code */
+static int temps = 0;				/* number of pushes on the temporary stack */
+static bool *returns = NULL;		/* set when a return statement is found */
+
+static struct {
+	bool do_loop;	/* continue must jump to the condition */
+	int label;
+} loop[MAXINDENT];
+static int loops = 0;				/* number of nested loops */
+
+
+static void statement(void);
+static Expr comma(void);
+static Expr assignment(void);
+static Expr logical_or(void);
+static const char *compound(token_t t);
+static bool is_assignment(token_t t);
+
+
+/* Append text to a buffer.
+ */
+static void append(Buffer *buffer, const char *text, size_t len)
+{
+	if (buffer->len + len + 1 > buffer->size) {
+		buffer->size = (buffer->len + len + 1) * 2;
+		if ((buffer->text = realloc(buffer->text, buffer->size)) == NULL)
+			error(OutOfMemoryError);
+	}
+	memcpy(buffer->text + buffer->len, text, len);
+	buffer->len += len;
+	buffer->text[buffer->len] = 0;
+}
+
+
+/* Append the text from buffer 'code' to 'out', optionally removing one tab
+ * from the start of every line. The memory used by 'code' is released.
+ */
+static void append_code(Buffer *code, bool dedent)
+{
+	char *line, *end;
+
+	for (line = code->text; line && *line; line = end) {
+		end = strchr(line, '\n') + 1;
+		if (dedent && *line == '\t')
+			line++;
+		append(out, line, (size_t)(end - line));
+	}
+	free(code->text);
+}
+
+
+/* Write a line of C code at the current indentation level.
+ */
+static void emit(const char *format, ...)
+{
+	char line[2 * CODESIZE];
+	va_list argp;
+	int i;
+
+	for (i = 0; i < indent; i++)
+		append(out, "\t", 1);
+
+	va_start(argp, format);
+	vsnprintf(line, sizeof line, format, argp);
+	va_end(argp);
+
+	append(out, line, strlen(line));
+	append(out, "\n", 1);
+}
+
+
+/* Return a C string literal for string s.
+ *
+ * The result is valid until the next call.
+ */
+static char *quote(const char *s)
+{
+	static char buffer[4 * BUFSIZE + 3];
+	char *p = buffer;
+
+	*p++ = '"';
+	for (; *s && p < buffer + sizeof buffer - 6; s++)
+		if (*s == '"' || *s == '\\')
+			p += sprintf(p, "\\%c", *s);
+		else if (*s < ' ' || *s > '~')
+			p += sprintf(p, "\\%03o", (unsigned char)*s);
+		else
+			*p++ = *s;
+	*p++ = '"';
+	*p = 0;
+
+	return buffer;
+}
+
+
+/* Variable tables.
+ */
+static Variable *search_variable(Variable *vars, const char *name)
+{
+	for (; vars; vars = vars->next)
+		if (strcmp(vars->name, name) == 0)
+			break;
+
+	return vars;
+}
+
+
+static Variable *add_variable(Variable **vars, const char *name)
+{
+	Variable *v;
+
+	if ((v = search_variable(*vars, name)) == NULL) {
+		if ((v = calloc(1, sizeof(Variable))) == NULL)
+			error(OutOfMemoryError);
+		if ((v->name = strdup(name)) == NULL)
+			error(OutOfMemoryError);
+		if ((v->cname = malloc(strlen(name) + 3)) == NULL)
+			error(OutOfMemoryError);
+		sprintf(v->cname, "%c_%s", vars == &globals ? 'g' : 'l', name);
+		v->ref = v->cname;
+		v->type = NONE_T;
+		v->kind = K_OBJ;
+		v->next = *vars;
+		*vars = v;
+	}
+	return v;
+}
+
+
+static Function *search_function(const char *name)
+{
+	Function *f;
+
+	for (f = functions; f; f = f->next)
+		if (strcmp(f->name, name) == 0)
+			break;
+
+	return f;
+}
+
+
+/* Search the variable an identifier refers to, first at local then at
+ * global level.
+ */
+static Variable *search(const char *name)
+{
+	Variable *v = NULL;
+
+	if (current)
+		v = search_variable(current->vars, name);
+	if (v == NULL)
+		v = search_variable(globals, name);
+
+	return v;
+}
+
+
+/* Pass 1: collect functions and variables.
+ */
+static void collect(Module *m);
+
+
+/* Return the type of the variables declared by token t.
+ */
+static objecttype_t declared_type(token_t t)
+{
+	switch (t) {
+		case DEFCHAR: return CHAR_T;
+		case DEFINT: return INT_T;
+		case DEFFLOAT: return FLOAT_T;
+		case DEFSTR: return STR_T;
+		case DEFLIST: return LIST_T;
+		case DEFHEAP: return HEAP_T;
+		case DEFDEQUE: return DEQUE_T;
+		case DEFMATRIX: return MATRIX_T;
+		case DEFBYTES: return BYTES_T;
+		default: return UNDEFINED;
+	}
+}
+
+
+/* Note the use of an identifier in the function which is being collected.
+ *
+ * Like in the interpreter a local variable only exists after its declaration
+ * has been executed, so until then the name refers to the global variable.
+ * This is certain only if the declaration came earlier in the same block or
+ * in an enclosing block. Otherwise the name is remembered, see shadow.
+ */
+static void collect_use(const char *name)
+{
+	Variable *v;
+
+	if (current == NULL)
+		return;
+
+	if ((v = search_variable(current->vars, name)) == NULL || v->level == 0)
+		add_variable(&current->used, name);
+}
+
+
+/* Register the names in a variable declaration.
+ *
+ * in:  token = first token after DEFCHAR, DEFINT, DEFFLOAT, DEFSTR, DEFLIST, DEFHEAP,
+ *       DEFDEQUE, DEFMATRIX, DEFBYTES
+ * out: token = NEWLINE
+ */
+static void collect_declaration(Variable **vars, objecttype_t type)
+{
+	bool name = true;
+	int depth = 0;
+	Variable *v;
+
+	while (scanner.token != NEWLINE && scanner.token != ENDMARKER) {
+		if (name && scanner.token == IDENTIFIER) {
+			v = add_variable(vars, scanner.string);
+			if (v->declared && v->type != type)
+				v->conflict = true;
+			v->declared = true;
+			v->type = type;
+			if (current && v->level == 0)
+				v->level = current->level;
+		} else if (scanner.token == IDENTIFIER)
+			collect_use(scanner.string);
+		name = false;
+		if (scanner.token == LPAR || scanner.token == LSQB)
+			depth++;
+		else if (scanner.token == RPAR || scanner.token == RSQB)
+			depth--;
+		else if (scanner.token == COMMA && depth == 0)
+			name = true;
+		scanner.next();
+	}
+}
+
+
+/* Inspect the statement at the current token for declared variables, loop
+ * variables and imported modules.
+ */
+static void collect_statement(Variable **vars)
+{
+	char name[BUFSIZE + 1];
+	objecttype_t type;
+
+	switch (scanner.token) {
+		case DEFCHAR:
+		case DEFINT:
+		case DEFFLOAT:
+		case DEFSTR:
+		case DEFLIST:
+		case DEFHEAP:
+		case DEFDEQUE:
+		case DEFMATRIX:
+		case DEFBYTES:
+			type = declared_type(scanner.token);
+			scanner.next();
+			collect_declaration(vars, type);
+			break;
+		case FOR:
+			scanner.next();
+			if (scanner.token == IDENTIFIER) {
+				collect_use(scanner.string);
+				add_variable(vars, scanner.string)->forvar = true;
+			}
+			scanner.next();
+			break;
+		case IMPORT:
+			scanner.next();
+			while (scanner.token != NEWLINE && scanner.token != ENDMARKER) {
+				if (scanner.token == STR) {
+					strcpy(name, scanner.string);
+					scanner.next();
+					if (isnative(name))
+						native_import(name);  /* makes its builtins known */
+					else
+						collect(module.search(name) ? module.search(name) : module.new(name));
+				} else
+					scanner.next();
+			}
+			break;
+		case IDENTIFIER:
+			collect_use(scanner.string);
+			scanner.next();
+			break;
+		default:
+			scanner.next();
+			break;
+	}
+}
+
+
+/* Register a function, its parameters and its local variables.
+ *
+ * A local variable which can be read before its declaration is executed is
+ * marked as shadow. See resolve().
+ *
+ * in:  token = IDENTIFIER after DEFFUNC
+ * out: token = first token after DEDENT at end of function body
+ */
+static void collect_function(void)
+{
+	Function *f;
+	Variable *v;
+
+	if (scanner.token != IDENTIFIER)
+		error(SyntaxError, "missing identifier after function definition");
+	if (search_function(scanner.string))
+		error(NameError, "%s is allready declared", scanner.string);
+
+	if ((f = calloc(1, sizeof(Function))) == NULL)
+		error(OutOfMemoryError);
+	if ((f->name = strdup(scanner.string)) == NULL)
+		error(OutOfMemoryError);
+	f->pos = reader.save();
+	f->next = functions;
+	functions = f;
+
+	expect(IDENTIFIER);
+	expect(LPAR);
+
+	while (scanner.token != RPAR) {
+		if (scanner.token != IDENTIFIER)
+			error(SyntaxError, "expected identifier instead of %s", \
+								tokenName(scanner.token));
+		v = add_variable(&f->vars, scanner.string);
+		v->param = true;
+		v->level = 1;
+		if ((f->param = realloc(f->param, (f->nparams + 1) * sizeof(Variable *))) == NULL)
+			error(OutOfMemoryError);
+		f->param[f->nparams++] = v;
+		expect(IDENTIFIER);
+		accept(COMMA);
+	}
+
+	expect(RPAR);
+	expect(NEWLINE);
+	expect(INDENT);
+
+	current = f;
+	f->level = 1;
+
+	while (f->level && scanner.token != ENDMARKER) {
+		if (scanner.token == INDENT)
+			f->level++;
+		if (scanner.token == DEDENT) {
+			f->level--;
+			for (v = f->vars; v; v = v->next)  /* declarations in the block go out of scope */
+				if (v->level > f->level)
+					v->level = 0;
+		}
+		if (scanner.token == INDENT || scanner.token == DEDENT || scanner.token == DEFFUNC)
+			scanner.next();
+		else
+			collect_statement(&f->vars);
+	}
+
+	current = NULL;
+
+	for (v = f->vars; v; v = v->next)
+		if (v->declared && search_variable(f->used, v->name))
+			v->shadow = true;
+}
+
+
+/* Read a module and all modules it imports.
+ */
+static void collect(Module *m)
+{
+	PositionObject *pos = NULL;
+	Function *caller;
+	Unit *u, **last;
+	int number = 0;
+
+	for (last = &units; *last; last = &(*last)->next, number++)
+		if ((*last)->module == m)
+			return;  /* already read */
+
+	if ((u = calloc(1, sizeof(Unit))) == NULL)
+		error(OutOfMemoryError);
+	u->module = m;
+	u->number = number;
+	*last = u;
+
+	if (reader.current) {  /* imported from another module */
+		pos = reader.save();
+		scope.append_level();
+	}
+
+	reader.current = m;
+	reader.reset();
+	scanner.next();
+
+	caller = current;  /* when imported from within a function */
+	current = NULL;
+
+	while (scanner.token != ENDMARKER)
+		if (accept(DEFFUNC))
+			collect_function();
+		else
+			collect_statement(&globals);
+
+	current = caller;
+
+	if (pos) {
+		scope.remove_level();
+		reader.jump(pos);
+		obj_decref(pos);
+	}
+}
+
+
+/* Decide how every variable is represented in C.
+ *
+ * A loop variable in a function which is not declared locally refers to
+ * the global variable with the same name, if it exists.
+ *
+ * A shadow variable refers to the global variable with the same name as
+ * long as the local variable does not exist. Both remain objects, as the
+ * global variable can have any type.
+ */
+static void resolve_variables(Variable *vars)
+{
+	for (; vars; vars = vars->next)
+		if (vars->declared && !vars->conflict && !vars->param && !vars->forvar && !vars->shadow) {
+			vars->typed = true;
+			if (vars->type == INT_T)
+				vars->kind = K_INT;
+			else if (vars->type == FLOAT_T)
+				vars->kind = K_FLOAT;
+		}
+}
+
+
+static void resolve(void)
+{
+	Variable **v, *g;
+
+	for (Function *f = functions; f; f = f->next)
+		for (v = &f->vars; *v; )
+			if ((*v)->forvar && !(*v)->declared && !(*v)->param \
+				&& (g = search_variable(globals, (*v)->name)) != NULL) {
+				g->forvar = true;
+				*v = (*v)->next;
+			} else
+				v = &(*v)->next;
+
+	for (Function *f = functions; f; f = f->next)
+		for (Variable *l = f->vars; l; l = l->next)
+			if (l->shadow && (g = search_variable(globals, l->name)) != NULL) {
+				g->shadow = true;
+				if ((l->ref = malloc(2 * strlen(l->cname) + strlen(g->cname) + 16)) == NULL)
+					error(OutOfMemoryError);
+				sprintf(l->ref, "(*(%s ? &%s : &%s))", l->cname, l->cname, g->cname);
+			}
+
+	resolve_variables(globals);
+	for (Function *f = functions; f; f = f->next)
+		resolve_variables(f->vars);
+}
+
+
+/* Pass 2: translate expressions.
+ */
+static const char *ctype[] = { "int_t ", "float_t ", "Object *" };
+
+
+/* Type checks on the types of expressions which are known while translating.
+ */
+static const char *typename[] = {
+	[UNDEFINED] = "", [CHAR_T] = "char", [INT_T] = "int", [FLOAT_T] = "float", [STR_T] = "str",
+	[LIST_T] = "list", [LISTNODE_T] = "listnode", [POSITION_T] = "position", [NONE_T] = "none",
+	[HEAP_T] = "heap", [DEQUE_T] = "deque", [MATRIX_T] = "matrix",
+	[BYTES_T] = "bytes"
+	};
+
+#define known(t)		((t) != UNDEFINED)
+#define numeric(t)		((t) == CHAR_T || (t) == INT_T || (t) == FLOAT_T)
+#define integral(t)		((t) == CHAR_T || (t) == INT_T)
+#define indexable(t)	((t) == STR_T || (t) == LIST_T || (t) == DEQUE_T || (t) == MATRIX_T || \
+						 (t) == BYTES_T)
+
+
+static Expr make(kind_t kind, bool stable, const char *format, ...)
+{
+	Expr e = { .kind = kind, .stable = stable, .var = NULL };
+
+	e.type = kind == K_INT ? INT_T : kind == K_FLOAT ? FLOAT_T : UNDEFINED;
+	va_list argp;
+
+	va_start(argp, format);
+	if (vsnprintf(e.code, CODESIZE, format, argp) >= CODESIZE)
+		error(SystemError, "expression too long to translate");
+	va_end(argp);
+
+	return e;
+}
+
+
+/* Store the value of an expression in a new C variable.
+ */
+static Expr spill(Expr e)
+{
+	if (e.stable)
+		return e;
+
+	emit("%s%c%d = %s;", ctype[e.kind], "ift"[e.kind], ++counter, e.code);
+
+	return make(e.kind, true, "%c%d", "ift"[e.kind], counter);
+}
+
+
+/* Create a temporary object. Format is C code which pushes an object on
+ * the stack with temporary objects and returns it.
+ */
+static Expr temp(const char *format, ...)
+{
+	char code[CODESIZE];
+	va_list argp;
+
+	va_start(argp, format);
+	vsnprintf(code, CODESIZE, format, argp);
+	va_end(argp);
+
+	emit("Object *t%d = %s;", ++counter, code);
+	temps++;
+
+	return make(K_OBJ, true, "t%d", counter);
+}
+
+
+/* Convert an expression to an object.
+ */
+static Expr box(Expr e)
+{
+	objecttype_t type = e.type;
+
+	if (e.kind == K_INT)
+		e = temp("rt_int(%s)", e.code);
+	else if (e.kind == K_FLOAT)
+		e = temp("rt_float(%s)", e.code);
+	e.type = type;
+
+	return e;
+}
+
+
+/* Convert an expression to a C number of kind 'kind'.
+ */
+static Expr convert(Expr e, kind_t kind)
+{
+	if (e.kind == kind)
+		return e;
+	if (kind == K_INT)
+		return make(K_INT, false, e.kind == K_FLOAT ? "((int_t)%s)" : "obj_as_int(%s)", e.code);
+	else
+		return make(K_FLOAT, false, e.kind == K_INT ? "((float_t)%s)" : "obj_as_float(%s)", e.code);
+}
+
+
+/* Return C code which tests if an expression is true.
+ */
+static Expr truth(Expr e)
+{
+	if (e.kind == K_OBJ)
+		return make(K_INT, false, "obj_as_bool(%s)", e.code);
+	return e;
+}
+
+
+/* Return C code for a new object which can be stored in a list or, if
+ * 'pass' is true, passed as argument to a function (see obj_pass()).
+ */
+static Expr argument(Expr e, bool pass)
+{
+	if (e.kind == K_INT)
+		return make(K_OBJ, false, "obj_new_int(%s)", e.code);
+	if (e.kind == K_FLOAT)
+		return make(K_OBJ, false, "obj_new_float(%s)", e.code);
+	return make(K_OBJ, false, pass ? "rt_pass(%s)" : "rt_arg(%s)", e.code);
+}
+
+
+/* Evaluate an expression only for its side effects.
+ */
+static void discard(Expr e)
+{
+	if (!e.stable)
+		emit("(void)%s;", e.code);
+}
+
+
+/* Translate the right operand of a binary operator.
+ *
+ * If the right operand needs C statements the left operand is stored first,
+ * so it is evaluated before the right operand, like in the interpreter.
+ */
+static Expr operand(Expr (*parse)(void), Expr *left)
+{
+	Buffer code = { NULL, 0, 0 }, *save = out;
+	Expr right;
+
+	out = &code;
+	right = parse();
+	out = save;
+
+	if (code.len) {
+		*left = spill(*left);
+		append_code(&code, false);
+	}
+	return right;
+}
+
+
+/* Return the type of the result of binary operator 'op' on operands of
+ * type l and r, or UNDEFINED if this is not known. An operation which will
+ * always fail is reported as an error, with the message obj_...() gives.
+ */
+static objecttype_t result_type(token_t op, const char *symbol, objecttype_t l, objecttype_t r)
+{
+	bool fails = false;
+
+	/* elementwise operations on matrices, checked by obj_...() */
+	if ((l == MATRIX_T || r == MATRIX_T) && strlen(symbol) == 1 && strchr("+-*/", *symbol))
+		return UNDEFINED;
+
+	switch (op) {
+		case PLUS:
+		case PLUSEQUAL:
+			if (l == STR_T || r == STR_T)
+				return STR_T;
+			if (l == LIST_T && r == LIST_T)
+				return LIST_T;
+			if (l == BYTES_T && r == BYTES_T)
+				return BYTES_T;
+			fails = !(numeric(l) && numeric(r));
+			break;
+		case STAR:
+		case STAREQUAL:
+			fails = !numeric(l) && !numeric(r);
+			if (!fails && (l == STR_T || r == STR_T))
+				return STR_T;
+			if (!fails && (l == LIST_T || r == LIST_T))
+				return LIST_T;
+			break;
+		case AMPER: case AMPEREQUAL:
+		case VBAR: case VBAREQUAL:
+		case CIRCUMFLEX: case CIRCUMFLEXEQUAL:
+		case LEFTSHIFT: case LEFTSHIFTEQUAL:
+		case RIGHTSHIFT: case RIGHTSHIFTEQUAL:
+			fails = !(integral(l) && integral(r));
+			break;
+		case EQEQUAL:
+		case NOTEQUAL:
+			return INT_T;
+		case IN:
+			if (known(r) && !indexable(r))
+				error(TypeError, "%s is not subscriptable", typename[r]);
+			return INT_T;
+		default:
+			fails = !(numeric(l) && numeric(r));
+			break;
+	}
+
+	if (fails && known(l) && known(r))
+		error(TypeError, "unsupported operand type(s) for operation %s: %s and %s", \
+						  symbol, typename[l], typename[r]);
+
+	return (op == LESS || op == LESSEQUAL || op == GREATER || op == GREATEREQUAL) ? INT_T : UNDEFINED;
+}
+
+
+/* Combine two operands with a binary operator.
+ */
+static Expr binary(token_t op, Expr l, Expr r)
+{
+	kind_t kind = (l.kind == K_FLOAT || r.kind == K_FLOAT) ? K_FLOAT : K_INT;
+	const char *fn = NULL, *cop = NULL, *symbol = NULL;
+	bool bitwise = false;
+	objecttype_t type;
+	Expr e;
+
+	if (strlen(l.code) + strlen(r.code) + 64 > CODESIZE) {
+		l = spill(l);
+		r = spill(r);
+	}
+
+	switch (op) {
+		case STAR: case STAREQUAL: fn = "obj_mult"; cop = symbol = "*"; break;
+		case SLASH: case SLASHEQUAL: fn = "obj_divs"; symbol = "/"; break;
+		case PERCENT: case PERCENTEQUAL: fn = "obj_mod"; symbol = "%"; break;
+		case PLUS: case PLUSEQUAL: fn = "obj_add"; cop = symbol = "+"; break;
+		case MINUS: case MINUSEQUAL: fn = "obj_sub"; cop = symbol = "-"; break;
+		case LESS: fn = "obj_lss"; cop = symbol = "<"; break;
+		case LESSEQUAL: fn = "obj_leq"; cop = symbol = "<="; break;
+		case GREATER: fn = "obj_gtr"; cop = symbol = ">"; break;
+		case GREATEREQUAL: fn = "obj_geq"; cop = symbol = ">="; break;
+		case EQEQUAL: fn = "obj_eql"; cop = symbol = "=="; break;
+		case NOTEQUAL: fn = "obj_neq"; cop = symbol = "!="; break;
+		case IN: fn = "obj_in"; symbol = "in"; break;
+		case AMPER: case AMPEREQUAL: fn = "obj_bitand"; cop = symbol = "&"; bitwise = true; break;
+		case VBAR: case VBAREQUAL: fn = "obj_bitor"; cop = symbol = "|"; bitwise = true; break;
+		case CIRCUMFLEX: case CIRCUMFLEXEQUAL: fn = "obj_bitxor"; cop = symbol = "^"; bitwise = true; break;
+		case LEFTSHIFT: case LEFTSHIFTEQUAL: fn = "obj_lshift"; symbol = "<<"; bitwise = true; break;
+		case RIGHTSHIFT: case RIGHTSHIFTEQUAL: fn = "obj_rshift"; symbol = ">>"; bitwise = true; break;
+		default:
+			error(SystemError, "cannot translate operator %s", tokenName(op));
+	}
+
+	type = result_type(op, symbol, l.type, r.type);
+
+	/* a float operand of a bitwise operator is left to obj_...() to report */
+	if (l.kind != K_OBJ && r.kind != K_OBJ && op != IN && !(bitwise && kind == K_FLOAT)) {
+		if (op == SLASH || op == SLASHEQUAL)
+			return make(kind, false, kind == K_INT ? "rt_idiv(%s, %s)" : "rt_fdiv(%s, %s)", l.code, r.code);
+		if ((op == PERCENT || op == PERCENTEQUAL) && kind == K_INT)
+			return make(K_INT, false, "rt_imod(%s, %s)", l.code, r.code);
+		if (op == LEFTSHIFT || op == LEFTSHIFTEQUAL)
+			return make(K_INT, false, "rt_ilshift(%s, %s)", l.code, r.code);
+		if (op == RIGHTSHIFT || op == RIGHTSHIFTEQUAL)
+			return make(K_INT, false, "int_rshift(%s, %s)", l.code, r.code);
+		if (kind == K_INT && cop && strchr("+-*", *cop))  /* checked for overflow */
+			return make(K_INT, false, "rt_i%s(%s, %s)", *cop == '+' ? "add" : *cop == '-' ? "sub" : "mul", \
+						l.code, r.code);
+		if (cop) {
+			if (strchr("<>=!", *cop))
+				kind = K_INT;
+			return make(kind, false, "(%s %s %s)", l.code, cop, r.code);
+		}
+	}
+
+	/* operands of different types are by definition not equal */
+	if ((op == EQEQUAL || op == NOTEQUAL) && known(l.type) && known(r.type) && \
+		(numeric(l.type) != numeric(r.type) || (!numeric(l.type) && l.type != r.type)))
+		return make(K_INT, true, op == EQEQUAL ? "0" : "1");
+
+	l = box(l);
+	r = box(r);
+
+	/* unchecked operations on strings and lists */
+	if (l.type == STR_T && r.type == STR_T) {
+		if (op == PLUS || op == PLUSEQUAL)
+			e = temp("rt_temp(strtype.concat(%s, %s))", l.code, r.code);
+		else if (op == EQEQUAL || op == NOTEQUAL)
+			return make(K_INT, false, "(%sstrtype.equal(%s, %s))", op == EQEQUAL ? "" : "!", l.code, r.code);
+		else
+			e = temp("rt_temp(%s(%s, %s))", fn, l.code, r.code);
+	} else if (l.type == LIST_T && r.type == LIST_T) {
+		if (op == PLUS || op == PLUSEQUAL)
+			e = temp("rt_temp(listtype.concat((ListObject *)%s, (ListObject *)%s))", l.code, r.code);
+		else if (op == EQEQUAL || op == NOTEQUAL)
+			return make(K_INT, false, "(%slisttype.equal((ListObject *)%s, (ListObject *)%s))", \
+						op == EQEQUAL ? "" : "!", l.code, r.code);
+		else
+			e = temp("rt_temp(%s(%s, %s))", fn, l.code, r.code);
+	} else
+		e = temp("rt_temp(%s(%s, %s))", fn, l.code, r.code);
+
+	e.type = type;
+
+	return e;
+}
+
+
+/* Translate an expression which is used as integer.
+ */
+static Expr int_expression(void)
+{
+	return spill(convert(logical_or(), K_INT));
+}
+
+
+/* Translate subscripts [index] and [start:end].
+ *
+ * The opening LSQB of the subscript has already been read.
+ *
+ * An assignment to an item whose sequence may be a row view of a matrix or
+ * a bytes object is translated here, as the element is not an object which
+ * can be assigned to (see element_assignment() in expression.c).
+ */
+static Expr subscript(Expr sequence)
+{
+	objecttype_t type = sequence.type;
+	Expr start, end, value;
+	bool slice;
+	token_t op;
+
+	if (known(type) && !indexable(type))
+		error(TypeError, "%s is not subscriptable", typename[type]);
+
+	sequence = box(sequence);
+	if (!known(type))
+		emit("rt_sequence(%s);", sequence.code);
+
+	while (1) {
+		slice = false;
+		start = make(K_INT, true, "0");
+		end = make(K_INT, true, "INT_MAX");
+
+		if (accept(COLON))
+			slice = true;
+		else
+			start = int_expression();
+		if (accept(COLON))
+			slice = true;
+		if (!accept(RSQB)) {
+			end = int_expression();
+			expect(RSQB);
+		}
+
+		if (known(type) && !indexable(type))
+			error(TypeError, "type %s is not subscriptable", typename[type]);
+
+		if (!slice && (!known(type) || type == MATRIX_T || type == BYTES_T) && is_assignment(op = scanner.token)) {
+			scanner.next();
+			value = box(op == EQUAL ? assignment() : logical_or());
+			return temp("rt_setitem(%s, %s, %s, %s)", sequence.code, start.code, \
+						op == EQUAL ? "NULL" : compound(op), value.code);
+		}
+
+		if (type == STR_T && slice)
+			sequence = temp("rt_index((Object *)strtype.slice((StrObject *)%s, (int)%s, (int)%s))", \
+							sequence.code, start.code, end.code);
+		else if (type == STR_T)
+			sequence = temp("rt_index((Object *)strtype.item((StrObject *)%s, (int)%s))", \
+							sequence.code, start.code);
+		else if (type == LIST_T && slice)
+			sequence = temp("rt_index((Object *)listtype.slice((ListObject *)%s, (int)%s, (int)%s))", \
+							sequence.code, start.code, end.code);
+		else if (type == LIST_T)
+			sequence = temp("rt_index((Object *)listtype.item((ListObject *)%s, (int)%s))", \
+							sequence.code, start.code);
+		else if (slice)
+			sequence = temp("rt_slice(%s, %s, %s)", sequence.code, start.code, end.code);
+		else
+			sequence = temp("rt_item(%s, %s)", sequence.code, start.code);
+
+		/* an item of a string is a char, of bytes an int, an item of a list can be anything */
+		sequence.type = type = slice ? type : type == STR_T ? CHAR_T : type == BYTES_T ? INT_T : UNDEFINED;
+
+		if (!accept(LSQB))
+			break;
+	}
+	return sequence;
+}
+
+
+/* Skip the argument list of a call which cannot be executed.
+ */
+static void skip_arguments(void)
+{
+	int depth = 0;
+
+	if (scanner.token != LPAR)
+		return;
+
+	do {
+		if (scanner.token == LPAR)
+			depth++;
+		if (scanner.token == RPAR)
+			depth--;
+		scanner.next();
+	} while (depth && scanner.token != NEWLINE && scanner.token != ENDMARKER);
+}
+
+
+/* Translate methods, e.g. seq.len, list.append(obj)
+ *
+ * The DOT which indicates a method will follow has already been read. The
+ * methods of lists and strings are translated to direct calls. Methods of
+ * other types, or of objects whose type is not known, are called via the
+ * method table of the type by rt_call_method().
+ */
+static Expr method(Expr object)
+{
+	char name[BUFSIZE + 1], code[CODESIZE] = "";
+	objecttype_t type;
+	Expr index, obj;
+	Method *m = NULL;
+	int argc = NOARGLIST;
+
+	if (scanner.token != IDENTIFIER)
+		error(SyntaxError, "expected method");
+
+	strcpy(name, scanner.string);
+	type = object.type;
+
+	if (known(type) && (m = obj_method(type, name)) == NULL)
+		error(SyntaxError, "unknown method %s for type %s", name, typename[type]);
+
+	object = box(object);
+	expect(IDENTIFIER);
+
+	if (type != LIST_T && type != STR_T) {
+		if (accept(LPAR)) {
+			argc = 0;
+			while (scanner.token != RPAR) {
+				obj = argument(logical_or(), false);
+				if (strlen(code) + strlen(obj.code) + 3 > CODESIZE)
+					error(SystemError, "expression too long to translate");
+				if (argc++)
+					strcat(code, ", ");
+				strcat(code, obj.code);
+				if (!accept(COMMA))
+					break;
+			}
+			expect(RPAR);
+		}
+		if (m && argc != m->nargs)
+			error(TypeError, "%s() takes %d argument(s)", name, m->nargs);
+		if (argc > 0)
+			return temp("rt_temp(rt_call_method(%s, %s, %d, (Object *[]){ %s }))", \
+						object.code, quote(name), argc, code);
+		return temp("rt_temp(rt_call_method(%s, %s, %d, NULL))", object.code, quote(name), argc);
+	}
+
+	if (strcmp("insert", name) == 0) {
+		expect(LPAR);
+		index = int_expression();
+		expect(COMMA);
+		obj = argument(logical_or(), false);
+		emit("listtype.insert((ListObject *)%s, %s, %s);", object.code, index.code, obj.code);
+		expect(RPAR);
+		return temp("rt_none()");
+	} else if (strcmp("append", name) == 0) {
+		expect(LPAR);
+		obj = argument(logical_or(), false);
+		emit("listtype.append((ListObject *)%s, %s);", object.code, obj.code);
+		expect(RPAR);
+		return temp("rt_none()");
+	} else if (strcmp("remove", name) == 0) {
+		expect(LPAR);
+		index = int_expression();
+		expect(RPAR);
+		return temp("rt_remove(%s, %s)", object.code, index.code);
+	} else if (strcmp("len", name) == 0) {
+		if (type == STR_T)
+			return make(K_INT, false, "strtype.size((StrObject *)%s)", object.code);
+		return make(K_INT, false, "listtype.size((ListObject *)%s)", object.code);
+	}
+
+	error(SystemError, "cannot translate method %s for type %s", name, typename[type]);
+	return temp("rt_none()");
+}
+
+
+/* Translate the part of an expression which comes after the identifier,
+ * function call or constant.
+ */
+static Expr trailer(Expr e)
+{
+	if (accept(LSQB))
+		e = subscript(e);
+	if (accept(DOT))
+		e = method(e);
+
+	return e;
+}
+
+
+/* Translate a call of a function, see function_call() in parser.c.
+ *
+ * in:  token = IDENTIFIER of the function
+ * out: token = token after RPAR of function call
+ */
+static Expr call(Function *f)
+{
+	char code[CODESIZE] = "";
+	int argc = 0, *arg = NULL;
+	Expr e;
+
+	expect(IDENTIFIER);
+	expect(LPAR);
+
+	while (scanner.token != RPAR) {
+		e = argument(assignment(), true);
+		emit("Object *a%d = %s;", ++counter, e.code);
+		if ((arg = realloc(arg, (argc + 1) * sizeof(int))) == NULL)
+			error(OutOfMemoryError);
+		arg[argc++] = counter;
+		if (scanner.token == RPAR)
+			continue;
+		else
+			expect(COMMA);
+	}
+	accept(RPAR);
+
+	if (argc < f->nparams)
+		emit("error(SyntaxError, \"no argument on stack to assign to %%s\", %s);", \
+			 quote(f->param[argc]->name));
+
+	for (int i = 0; i < f->nparams; i++) {
+		if (strlen(code) + 16 > CODESIZE)
+			error(SystemError, "expression too long to translate");
+		if (i)
+			strcat(code, ", ");
+		if (i < argc)
+			sprintf(code + strlen(code), "a%d", arg[i]);
+		else
+			strcat(code, "NULL");
+	}
+	e = temp("rt_temp(f_%s(%s))", f->name, code);
+
+	for (int i = f->nparams; i < argc; i++)
+		emit("obj_decref(a%d);", arg[i]);
+
+	free(arg);
+
+	return e;
+}
+
+
+/* Translate a call of a math builtin whose arguments are all C variables
+ * or expressions into a direct call of the C function. The result is again
+ * a C value, so it is not boxed into an object.
+ *
+ * return   true if the call was translated, false if it must go via
+ *          builtin_call()
+ */
+static bool math_expr(const char *name, int argc, Expr *argv, Expr *result)
+{
+	static const struct {
+		char *name;
+		int nargs;
+		char *ifunction;	/* function if all arguments are K_INT, NULL if none */
+		char *ffunction;	/* function in all other cases, NULL if none */
+	} math[] = {
+		{"abs", 1, "math_iabs", "fabs"},
+		{"ceil", 1, "", "ceil"},
+		{"cos", 1, NULL, "cos"},
+		{"exp", 1, NULL, "exp"},
+		{"floor", 1, "", "floor"},
+		{"log", 1, NULL, "math_log"},
+		{"max", 2, "math_imax", "math_fmax"},
+		{"min", 2, "math_imin", "math_fmin"},
+		{"pow", 2, "math_ipow", "pow"},
+		{"randint", 2, "math_randint", NULL},
+		{"random", 0, NULL, "math_random"},
+		{"sin", 1, NULL, "sin"},
+		{"sqrt", 1, NULL, "math_sqrt"}
+	};
+	bool integer = true;
+	int i, m;
+
+	for (m = 0; m < (int)(sizeof math / sizeof math[0]); m++)
+		if (strcmp(name, math[m].name) == 0)
+			break;
+
+	if (m == (int)(sizeof math / sizeof math[0]) || argc != math[m].nargs)
+		return false;
+
+	for (i = 0; i < argc; i++) {
+		if (argv[i].kind == K_OBJ)
+			return false;
+		if (argv[i].kind == K_FLOAT)
+			integer = false;
+	}
+
+	if (integer && math[m].ifunction) {
+		if (argc == 0)
+			*result = make(K_INT, false, "%s()", math[m].ifunction);
+		else if (argc == 1)
+			*result = make(K_INT, false, "%s(%s)", math[m].ifunction, argv[0].code);
+		else
+			*result = make(K_INT, false, "%s(%s, %s)", math[m].ifunction, argv[0].code, argv[1].code);
+	} else if (math[m].ffunction) {
+		if (argc == 0)
+			*result = make(K_FLOAT, false, "%s()", math[m].ffunction);
+		else if (argc == 1)
+			*result = make(K_FLOAT, false, "%s((float_t)%s)", math[m].ffunction, argv[0].code);
+		else
+			*result = make(K_FLOAT, false, "%s((float_t)%s, (float_t)%s)", math[m].ffunction, \
+						   argv[0].code, argv[1].code);
+	} else
+		return false;
+
+	return true;
+}
+
+
+/* Translate a call of a builtin, see builtin() in function.c.
+ */
+static Expr builtin_expr(const char *name)
+{
+	char code[CODESIZE] = "";
+	Buffer buffer = { NULL, 0, 0 }, *save = out;
+	Expr argv[MAXARGS], arg;
+	int i, argc = 0;
+
+	expect(IDENTIFIER);
+	expect(LPAR);
+
+	/* arguments are evaluated from left to right, see operand() */
+	while (scanner.token != RPAR) {
+		if (argc == MAXARGS)
+			error(SyntaxError, "too many arguments for %s()", name);
+		out = &buffer;
+		argv[argc] = assignment();
+		out = save;
+		if (buffer.len)
+			for (i = 0; i < argc; i++)
+				argv[i] = spill(argv[i]);
+		append_code(&buffer, false);
+		buffer = (Buffer){ NULL, 0, 0 };
+		argc++;
+		if (!accept(COMMA))
+			break;
+	}
+	expect(RPAR);
+
+	if (math_expr(name, argc, argv, &arg))
+		return arg;
+
+	for (i = 0; i < argc; i++) {
+		arg = box(argv[i]);
+		if (strlen(code) + strlen(arg.code) + 3 > CODESIZE)
+			error(SystemError, "expression too long to translate");
+		if (i)
+			strcat(code, ", ");
+		strcat(code, arg.code);
+	}
+
+	if (argc)
+		return temp("rt_temp(builtin_call(%s, %d, (Object *[]){ %s }))", quote(name), argc, code);
+	else
+		return temp("rt_temp(builtin_call(%s, 0, NULL))", quote(name));
+}
+
+
+/* Translate variables, function calls, constants, (expression)
+ */
+static Expr primary(void)
+{
+	char name[BUFSIZE + 1];
+	Variable *v;
+	Function *f;
+	Expr e, item;
+	long i;
+
+	switch (scanner.token) {
+		case CHAR:
+			e = temp("rt_char((char_t)%d)", (int)str_to_char(scanner.string));
+			e.type = CHAR_T;
+			expect(CHAR);
+			break;
+		case INT:
+			errno = 0;
+			i = strtol(scanner.string, NULL, 10);
+			if (errno == ERANGE) {  /* too large for a C variable */
+				e = temp("rt_temp(int_from_str(\"%s\"))", scanner.string);
+				e.type = INT_T;
+			} else
+				e = make(K_INT, true, "%ldL", i);
+			expect(INT);
+			break;
+		case FLOAT:
+			e = make(K_FLOAT, true, "((float_t)%.17G)", str_to_float(scanner.string));
+			expect(FLOAT);
+			break;
+		case STR:
+			e = temp("rt_str(%s)", quote(scanner.string));
+			e.type = STR_T;
+			expect(STR);
+			break;
+		case LSQB:
+			e = temp("rt_list()");
+			e.type = LIST_T;
+			expect(LSQB);
+			while (accept(RSQB) == 0) {
+				do {
+					item = argument(assignment(), false);
+					emit("listtype.append((ListObject *)%s, %s);", e.code, item.code);
+				} while (accept(COMMA));
+			}
+			break;
+		case IDENTIFIER:
+			strcpy(name, scanner.string);
+			if ((v = search(name)) != NULL) {
+				expect(IDENTIFIER);
+				if (v->kind == K_OBJ) {
+					e = temp("rt_use(%s, %s)", v->ref, quote(name));
+					e.type = v->typed ? v->type : UNDEFINED;
+				} else {
+					e = make(v->kind, true, "%s", v->cname);
+					e.var = v;
+				}
+			} else if ((f = search_function(name)) != NULL)
+				e = call(f);
+			else if (isbuiltin(name))
+				e = builtin_expr(name);
+			else {
+				emit("error(NameError, \"identifier %%s is not defined\", %s);", quote(name));
+				expect(IDENTIFIER);
+				skip_arguments();
+				e = temp("rt_none()");
+			}
+			break;
+		case LPAR:
+			expect(LPAR);
+			e = comma();
+			expect(RPAR);
+			break;
+		default:
+			error(SyntaxError, "expression expected");
+	}
+	return trailer(e);
+}
+
+
+/* Operators: (unary)-  (unary)+  ! (logical negation, NOT)  ~ (complement)
+ */
+static Expr unary(void)
+{
+	Expr e;
+
+	if (accept(NOT)) {
+		e = primary();
+		if (known(e.type) && !numeric(e.type))
+			error(TypeError, "unsupported operand type for operation !: %s", typename[e.type]);
+		if (e.kind == K_OBJ)
+			return temp("rt_temp(obj_negate(%s))", e.code);
+		e = spill(e);
+		return make(K_INT, false, "(!%s)", e.code);
+	} else if (accept(MINUS)) {
+		e = primary();
+		if (known(e.type) && !numeric(e.type) && e.type != MATRIX_T)
+			error(TypeError, "unsupported operand type for operation -: %s", typename[e.type]);
+		if (e.kind == K_OBJ)
+			return temp("rt_temp(obj_invert(%s))", e.code);
+		e = spill(e);
+		return make(e.kind, false, "(-%s)", e.code);
+	} else if (accept(TILDE)) {
+		e = primary();
+		if (known(e.type) && !integral(e.type))
+			error(TypeError, "unsupported operand type for operation ~: %s", typename[e.type]);
+		if (e.kind != K_INT)
+			return temp("rt_temp(obj_complement(%s))", box(e).code);
+		e = spill(e);
+		return make(K_INT, false, "(~%s)", e.code);
+	} else if (accept(PLUS))
+		return primary();
+	else
+		return primary();
+}
+
+
+/* Operators: *  /  %
+ */
+static Expr multiplicative(void)
+{
+	Expr l, r;
+	token_t op;
+
+	l = unary();
+
+	while (scanner.token == STAR || scanner.token == SLASH || scanner.token == PERCENT) {
+		op = scanner.token;
+		scanner.next();
+		r = operand(unary, &l);
+		l = binary(op, l, r);
+	}
+	return l;
+}
+
+
+/* Operators: +  -
+ */
+static Expr additive(void)
+{
+	Expr l, r;
+	token_t op;
+
+	l = multiplicative();
+
+	while (scanner.token == PLUS || scanner.token == MINUS) {
+		op = scanner.token;
+		scanner.next();
+		r = operand(multiplicative, &l);
+		l = binary(op, l, r);
+	}
+	return l;
+}
+
+
+/* Operators: <<  >>
+ */
+static Expr shift(void)
+{
+	Expr l, r;
+	token_t op;
+
+	l = additive();
+
+	while (scanner.token == LEFTSHIFT || scanner.token == RIGHTSHIFT) {
+		op = scanner.token;
+		scanner.next();
+		r = operand(additive, &l);
+		l = binary(op, l, r);
+	}
+	return l;
+}
+
+
+/* Operators: &
+ */
+static Expr bitwise_and(void)
+{
+	Expr l, r;
+
+	l = shift();
+
+	while (accept(AMPER)) {
+		r = operand(shift, &l);
+		l = binary(AMPER, l, r);
+	}
+	return l;
+}
+
+
+/* Operators: ^
+ */
+static Expr bitwise_xor(void)
+{
+	Expr l, r;
+
+	l = bitwise_and();
+
+	while (accept(CIRCUMFLEX)) {
+		r = operand(bitwise_and, &l);
+		l = binary(CIRCUMFLEX, l, r);
+	}
+	return l;
+}
+
+
+/* Operators: |
+ */
+static Expr bitwise_or(void)
+{
+	Expr l, r;
+
+	l = bitwise_xor();
+
+	while (accept(VBAR)) {
+		r = operand(bitwise_xor, &l);
+		l = binary(VBAR, l, r);
+	}
+	return l;
+}
+
+
+/* Operators: <  <=  >  >=
+ */
+static Expr relational(void)
+{
+	Expr l, r;
+	token_t op;
+
+	l = bitwise_or();
+
+	while (scanner.token == LESS || scanner.token == LESSEQUAL || \
+		   scanner.token == GREATER || scanner.token == GREATEREQUAL) {
+		op = scanner.token;
+		scanner.next();
+		r = operand(relational, &l);
+		l = binary(op, l, r);
+	}
+	return l;
+}
+
+
+/* Operators: ==  !=  <>  in
+ */
+static Expr equality(void)
+{
+	Expr l, r;
+	token_t op;
+
+	l = relational();
+
+	while (scanner.token == EQEQUAL || scanner.token == NOTEQUAL || scanner.token == IN) {
+		op = scanner.token;
+		scanner.next();
+		r = operand(equality, &l);
+		l = binary(op, l, r);
+	}
+	return l;
+}
+
+
+/* Translate logical operator 'op' (AND or OR) with left operand l.
+ *
+ * The right operand is only evaluated if the left operand does not decide
+ * the result, see logical_and_expr() in expression.c.
+ */
+static Expr logical(token_t op, Expr l, Expr (*parse)(void))
+{
+	Buffer code = { NULL, 0, 0 }, *save = out;
+	int n = ++counter;
+	Expr r;
+
+	out = &code;
+	indent++;
+	r = parse();
+	indent--;
+	out = save;
+
+	/* only a number as left operand can decide the result on its own */
+	if (known(l.type) && !numeric(l.type) && known(r.type))
+		error(TypeError, "unsupported operand type(s) for operation %s: %s and %s", \
+						  op == AND ? "and" : "or", typename[l.type], typename[r.type]);
+
+	if (l.kind != K_OBJ && r.kind != K_OBJ) {
+		if (code.len == 0)
+			return make(K_INT, false, op == AND ? "(%s && %s)" : "(%s || %s)", l.code, r.code);
+		emit("int_t i%d = %d;", n, op == OR);
+		emit(op == AND ? "if (%s) {" : "if (!%s) {", l.code);
+		append_code(&code, false);
+		emit("\ti%d = %s != 0;", n, r.code);
+		emit("}");
+		return make(K_INT, true, "i%d", n);
+	}
+
+	emit("Object *t%d;", n);
+	if (l.kind != K_OBJ)
+		emit(op == AND ? "if (!%s)" : "if (%s)", l.code);
+	else
+		emit(op == AND ? "if (rt_isnum(%s) && !obj_as_bool(%s))" : "if (rt_isnum(%s) && obj_as_bool(%s))", \
+			 l.code, l.code);
+	emit("\tt%d = rt_int(%d);", n, op == OR);
+	emit("else {");
+	indent++;
+	append_code(&code, false);
+	l = box(l);
+	r = box(r);
+	emit("t%d = rt_temp(%s(%s, %s));", n, op == AND ? "obj_and" : "obj_or", l.code, r.code);
+	indent--;
+	emit("}");
+	temps++;
+
+	r = make(K_OBJ, true, "t%d", n);
+	r.type = INT_T;
+
+	return r;
+}
+
+
+/* Operators: logical and
+ */
+static Expr logical_and(void)
+{
+	Expr l;
+
+	l = equality();
+
+	while (accept(AND))
+		l = logical(AND, l, logical_and);
+
+	return l;
+}
+
+
+/* Operators: logical or
+ */
+static Expr logical_or(void)
+{
+	Expr l;
+
+	l = logical_and();
+
+	while (accept(OR))
+		l = logical(OR, l, logical_or);
+
+	return l;
+}
+
+
+/* Return the name of the operator function of compound assignment token t,
+ * or NULL if t is not a compound assignment.
+ */
+static const char *compound(token_t t)
+{
+	switch (t) {
+		case PLUSEQUAL: return "obj_add";
+		case MINUSEQUAL: return "obj_sub";
+		case STAREQUAL: return "obj_mult";
+		case SLASHEQUAL: return "obj_divs";
+		case PERCENTEQUAL: return "obj_mod";
+		case AMPEREQUAL: return "obj_bitand";
+		case VBAREQUAL: return "obj_bitor";
+		case CIRCUMFLEXEQUAL: return "obj_bitxor";
+		case LEFTSHIFTEQUAL: return "obj_lshift";
+		case RIGHTSHIFTEQUAL: return "obj_rshift";
+		default: return NULL;
+	}
+}
+
+
+static bool is_assignment(token_t t)
+{
+	return t == EQUAL || compound(t) != NULL;
+}
+
+
+/* Operators: =  +=  -=  *=  /=  %=  &=  |=  ^=  <<=  >>=
+ *
+ * A variable which holds a C number is assigned to directly. All other
+ * values are objects and are assigned to via obj_assign().
+ */
+static Expr assignment(void)
+{
+	Expr l, r;
+	token_t op;
+
+	l = logical_or();
+
+	if (is_assignment(scanner.token)) {
+		if (l.kind != K_OBJ && l.var == NULL)
+			l = box(l);
+		if (l.kind == K_OBJ && !indexable(l.type))  /* shared objects may not be modified */
+			emit("%s = rt_private(%s);", l.code, l.code);
+	}
+
+	while (is_assignment(op = scanner.token)) {
+		scanner.next();
+		if (op == EQUAL) {
+			r = assignment();
+			if (l.var)
+				emit("%s = %s;", l.code, convert(r, l.kind).code);
+			else {
+				r = box(r);
+				emit("obj_assign(%s, %s);", l.code, r.code);
+			}
+		} else {
+			r = logical_or();
+			if (l.var)
+				emit("%s = %s;", l.code, convert(binary(op, l, r), l.kind).code);
+			else {
+				r = box(r);
+				emit("rt_update(%s, %s, %s);", l.code, compound(op), r.code);
+			}
+		}
+	}
+	return l;
+}
+
+
+/* Operators: ,
+ */
+static Expr comma(void)
+{
+	Expr l;
+
+	l = assignment();
+
+	while (accept(COMMA)) {
+		discard(l);
+		l = comma();
+	}
+	return l;
+}
+
+
+/* Pass 2: translate statements.
+ */
+
+
+/* Translate a condition. The C statements which are needed are written to
+ * 'out', and the C expression which tests the condition is stored in cond.
+ */
+static void condition(char *cond)
+{
+	Buffer code = { NULL, 0, 0 }, *save = out;
+	int t = temps, n = ++counter;
+	Expr e;
+
+	out = &code;
+	indent++;
+	e = truth(comma());
+	indent--;
+	out = save;
+
+	if (code.len == 0) {
+		strcpy(cond, e.code);
+		return;
+	}
+
+	emit("bool c%d;", n);
+	emit("{");
+	if (temps != t)
+		emit("\tsize_t m%d = rt_mark();", n);
+	append_code(&code, false);
+	emit("\tc%d = %s;", n, e.code);
+	if (temps != t)
+		emit("\trt_release(m%d);", n);
+	emit("}");
+
+	sprintf(cond, "c%d", n);
+}
+
+
+/* Translate a statement block.
+ *
+ * Syntax: NEWLINE INDENT statement+ DEDENT
+ *
+ * in:  token = NEWLINE
+ * out: token = DEDENT
+ */
+static void block(void)
+{
+	expect(NEWLINE);
+	expect(INDENT);
+
+	indent++;
+	while (1) {
+		statement();
+		if (scanner.token == DEDENT || scanner.token == ENDMARKER)
+			break;
+	}
+	indent--;
+}
+
+
+/* Skip a function definition, see skip_function() in parser.c.
+ */
+static void skip_function(void)
+{
+	int level = 1;
+
+	expect(IDENTIFIER);
+	expect(LPAR);
+
+	while (scanner.token != NEWLINE && scanner.token != ENDMARKER)
+		scanner.next();
+
+	expect(NEWLINE);
+	expect(INDENT);
+
+	do {
+		scanner.next();
+		if (scanner.token == INDENT)
+			level++;
+		if (scanner.token == DEDENT)
+			level--;
+	} while (level && scanner.token != ENDMARKER);
+
+	scanner.next();
+}
+
+
+static void variable_declaration(objecttype_t type)
+{
+	static const char *constant[] = {
+		[UNDEFINED] = "UNDEFINED", [CHAR_T] = "CHAR_T", [INT_T] = "INT_T", [FLOAT_T] = "FLOAT_T",
+		[STR_T] = "STR_T", [LIST_T] = "LIST_T", [HEAP_T] = "HEAP_T", [DEQUE_T] = "DEQUE_T",
+		[MATRIX_T] = "MATRIX_T", [BYTES_T] = "BYTES_T"
+		};
+	Variable *v;
+	Expr e;
+	bool init;
+
+	while (1) {
+		if (scanner.token != IDENTIFIER)
+			error(SyntaxError, "expected identifier instead of %s", \
+								tokenName(scanner.token));
+		v = search(scanner.string);
+		scanner.next();
+
+		if ((init = accept(EQUAL)) == true)
+			e = assignment();
+
+		if (v->kind == K_OBJ)
+			emit("rt_declare(&%s, %s, %s);", v->cname, constant[type], init ? box(e).code : "NULL");
+		else
+			emit("%s = %s;", v->cname, init ? convert(e, v->kind).code : "0");
+
+		if (accept(NEWLINE))
+			break;
+		expect(COMMA);
+	}
+}
+
+
+static void expression_stmnt(void)
+{
+	discard(comma());
+	expect(NEWLINE);
+}
+
+
+static void if_stmnt(void)
+{
+	char cond[CODESIZE];
+
+	condition(cond);
+	emit("if (%s) {", cond);
+	block();
+	expect(DEDENT);
+	if (accept(ELSE)) {
+		emit("} else {");
+		block();
+		expect(DEDENT);
+	}
+	emit("}");
+}
+
+
+static void while_stmnt(void)
+{
+	Buffer code = { NULL, 0, 0 }, *save = out;
+	char cond[CODESIZE];
+
+	out = &code;
+	indent++;
+	condition(cond);
+	indent--;
+	out = save;
+
+	if (code.len == 0)
+		emit("while (%s) {", cond);
+	else {
+		emit("while (1) {");
+		append_code(&code, false);
+		emit("\tif (!%s)", cond);
+		emit("\t\tbreak;");
+	}
+
+	loop[loops].do_loop = false;
+	loops++;
+	block();
+	loops--;
+
+	emit("}");
+	accept(DEDENT);
+}
+
+
+/* do
+ *     block
+ * while condition NEWLINE
+ *
+ * A continue in the block jumps to the condition.
+ */
+static void do_stmnt(void)
+{
+	char cond[CODESIZE];
+	int n = ++counter;
+
+	if (scanner.token != NEWLINE)
+		error(SyntaxError, "expected newline after do");
+
+	emit("while (1) {");
+
+	loop[loops].do_loop = true;
+	loop[loops].label = n;
+	loops++;
+	block();
+	loops--;
+
+	expect(DEDENT);
+	expect(WHILE);
+
+	indent++;
+	emit("next%d:", n);
+	condition(cond);
+	emit("if (!%s)", cond);
+	emit("\tbreak;");
+	indent--;
+	emit("}");
+
+	expect(NEWLINE);
+}
+
+
+/* for identifier in sequence NEWLINE
+ *      block
+ */
+static void for_stmnt(void)
+{
+	Variable *v = NULL;
+	int n = ++counter;
+	Expr sequence;
+
+	if (scanner.token == IDENTIFIER)
+		v = search(scanner.string);
+
+	expect(IDENTIFIER);
+	expect(IN);
+
+	emit("{");
+	indent++;
+	emit("size_t m%d = rt_mark();", n);
+	emit("if (%s == NULL)", v->ref);
+	emit("\t%s = obj_alloc(NONE_T);", v->ref);
+
+	sequence = box(comma());
+
+	if (known(sequence.type) && !indexable(sequence.type))
+		error(TypeError, "type %s is not subscriptable", typename[sequence.type]);
+
+	if (scanner.token != NEWLINE)
+		error(SyntaxError, "expected newline");
+
+	emit("int_t n%d = obj_length(%s);", n, sequence.code);
+	emit("for (int_t i%d = 0; i%d < n%d; i%d++) {", n, n, n, n);
+	emit("\trt_bind(&%s, obj_item(%s, (int)i%d));", v->ref, sequence.code, n);
+
+	loop[loops].do_loop = false;
+	loops++;
+	block();
+	loops--;
+
+	emit("}");
+	emit("rt_release(m%d);", n);
+	indent--;
+	emit("}");
+	accept(DEDENT);
+}
+
+
+/* Import a module. Only modules named by a string literal can be
+ * translated.
+ */
+static void import_stmt(void)
+{
+	char name[BUFSIZE + 1];
+	Unit *u;
+
+	do {
+		if (scanner.token != STR)
+			error(SyntaxError, "cannot translate import of a computed module name");
+		strcpy(name, scanner.string);
+		scanner.next();
+		if (scanner.token != COMMA && scanner.token != NEWLINE)
+			error(SyntaxError, "cannot translate import of a computed module name");
+		if (isnative(name))
+			emit("native_import(%s);", quote(name));
+		else
+			for (u = units; u; u = u->next)
+				if (u->module == module.search(name))
+					emit("m_%d();", u->number);
+	} while (accept(COMMA));
+	expect(NEWLINE);
+}
+
+
+/* Print a value like obj_print() does, including flushing stdout.
+ */
+static void print_expr(Expr e)
+{
+	if (e.kind == K_OBJ)
+		emit("obj_print(%s);", e.code);
+	else {
+		if (e.kind == K_INT)
+			emit("printf(\"%%ld\", (int_t)%s);", e.code);
+		else
+			emit("printf(\"%%.*G\", 15, (float_t)%s);", e.code);
+		emit("fflush(stdout);");
+	}
+}
+
+
+static void	print_stmnt(void)
+{
+	bool first = true;
+	bool raw = false;
+	Expr e;
+
+	if (scanner.token == MINUS) {
+		if (scanner.peek() == IDENTIFIER && strcmp(scanner.string, "raw") == 0) {
+			scanner.next();
+			scanner.next();
+			raw = true;
+		}
+	}
+
+	if (scanner.token != NEWLINE) {
+		do {
+			e = assignment();
+			if (first == true)
+				first = false;
+			else  /* first == false */
+				if (raw == false)
+					emit("printf(\" \");");
+			print_expr(e);
+		} while (accept(COMMA));
+	}
+	if (raw == false)
+		emit("printf(\"\\n\");");
+
+	expect(NEWLINE);
+}
+
+
+static void input_stmnt(void)
+{
+	Variable *v;
+
+	do {
+		if (scanner.token == STR) {
+			emit("printf(\"%%s\", %s);", quote(scanner.string));
+			emit("fflush(stdout);");
+			scanner.next();
+		}
+		if (scanner.token != IDENTIFIER)
+			error(SyntaxError, "expected identifier instead of %s", \
+								tokenName(scanner.token));
+		if ((v = search(scanner.string)) == NULL)
+			emit("error(NameError, \"identifier %%s undeclared\", %s);", quote(scanner.string));
+		else if (v->kind == K_OBJ)
+			emit("rt_input(&%s, %s);", v->ref, quote(scanner.string));
+		else {
+			emit("%s = %s(rt_scan(%s));", v->cname, v->kind == K_INT ? "obj_as_int" : "obj_as_float", \
+				 v->kind == K_INT ? "INT_T" : "FLOAT_T");
+			temps++;
+		}
+		accept(IDENTIFIER);
+	} while (accept(COMMA));
+
+	expect(NEWLINE);
+}
+
+
+static void return_stmt(void)
+{
+	Expr e;
+
+	if (scanner.token == NEWLINE)
+		emit("rv = inttype.shared(0);");
+	else {
+		e = comma();
+		if (e.kind == K_INT)
+			emit("rv = inttype.shared(%s);", e.code);
+		else if (e.kind == K_FLOAT)
+			emit("rv = obj_new_float(%s);", e.code);
+		else
+			emit("rv = rt_claim(%s);", e.code);
+	}
+	emit("goto leave;");
+	*returns = true;
+
+	expect(NEWLINE);
+}
+
+
+/* Translate a statement which does not contain other statements. Temporary
+ * objects which are created are released at the end of the statement.
+ */
+static void simple_statement(token_t t)
+{
+	Buffer code = { NULL, 0, 0 }, *save = out;
+	int n = temps;
+
+	out = &code;
+	indent++;
+
+	switch (t) {
+		case DEFCHAR: variable_declaration(CHAR_T); break;
+		case DEFINT: variable_declaration(INT_T); break;
+		case DEFFLOAT: variable_declaration(FLOAT_T); break;
+		case DEFSTR: variable_declaration(STR_T); break;
+		case DEFLIST: variable_declaration(LIST_T); break;
+		case DEFHEAP: variable_declaration(HEAP_T); break;
+		case DEFDEQUE: variable_declaration(DEQUE_T); break;
+		case DEFMATRIX: variable_declaration(MATRIX_T); break;
+		case DEFBYTES: variable_declaration(BYTES_T); break;
+		case INPUT: input_stmnt(); break;
+		case PRINT: print_stmnt(); break;
+		default: expression_stmnt(); break;
+	}
+
+	indent--;
+	out = save;
+
+	if (temps == n)
+		append_code(&code, true);
+	else {
+		emit("{");
+		emit("\tsize_t m%d = rt_mark();", ++counter);
+		append_code(&code, false);
+		emit("\trt_release(m%d);", counter);
+		emit("}");
+	}
+}
+
+
+/* Statement translator, see statement() in parser.c.
+ *
+ * in:  token = token to translate
+ * out: token = first token after statement
+ */
+static void statement(void)
+{
+	token_t t = scanner.token;
+
+	switch (t) {
+		case DEFCHAR:
+		case DEFINT:
+		case DEFFLOAT:
+		case DEFSTR:
+		case DEFLIST:
+		case DEFHEAP:
+		case DEFDEQUE:
+		case DEFMATRIX:
+		case DEFBYTES:
+		case INPUT:
+		case PRINT:
+			scanner.next();
+			simple_statement(t);
+			break;
+		case DEFFUNC:
+			scanner.next();
+			skip_function();
+			break;
+		case FOR:
+			scanner.next();
+			for_stmnt();
+			break;
+		case DO:
+			scanner.next();
+			do_stmnt();
+			break;
+		case IF:
+			scanner.next();
+			if_stmnt();
+			break;
+		case IMPORT:
+			scanner.next();
+			import_stmt();
+			break;
+		case PASS:
+			scanner.next();
+			expect(NEWLINE);
+			break;
+		case RETURN:
+		case DEDENT:  /* DEDENT is implicit 'return' at end of block */
+			scanner.next();
+			return_stmt();
+			break;
+		case WHILE:
+			scanner.next();
+			while_stmnt();
+			break;
+		case BREAK:
+			scanner.next();
+			if (loops)
+				emit("break;");
+			accept(NEWLINE);
+			break;
+		case CONTINUE:
+			scanner.next();
+			if (loops && loop[loops - 1].do_loop)
+				emit("goto next%d;", loop[loops - 1].label);
+			else if (loops)
+				emit("continue;");
+			accept(NEWLINE);
+			break;
+		case ENDMARKER:
+			scanner.next();
+			break;
+		default:
+			simple_statement(t);
+			break;
+	}
+}
+
+
+/* Translate the statements of a module.
+ */
+static void translate_module(Unit *u)
+{
+	current = NULL;
+	returns = &u->returns;
+	loops = 0;
+
+	if ((out = u->code = calloc(1, sizeof(Buffer))) == NULL)
+		error(OutOfMemoryError);
+	indent = 1;
+
+	reader.current = u->module;
+	reader.reset();
+	scanner.next();
+
+	while (1) {
+		statement();
+		if (accept(ENDMARKER))
+			break;
+	}
+}
+
+
+/* Translate the body of a function.
+ */
+static void translate_function(Function *f)
+{
+	current = f;
+	returns = &f->returns;
+	loops = 0;
+
+	if ((out = f->code = calloc(1, sizeof(Buffer))) == NULL)
+		error(OutOfMemoryError);
+	indent = 0;
+
+	scope.append_level();
+	reader.jump(f->pos);
+
+	expect(IDENTIFIER);
+	expect(LPAR);
+	while (scanner.token != RPAR) {
+		expect(IDENTIFIER);
+		accept(COMMA);
+	}
+	expect(RPAR);
+
+	block();
+
+	scope.remove_level();
+}
+
+
+/* Write the C code of a function.
+ */
+static void write_function(Function *f)
+{
+	Variable *v;
+
+	printf("static Object *f_%s(", f->name);
+	for (int i = 0; i < f->nparams; i++)
+		printf("%sObject *%s", i ? ", " : "", f->param[i]->cname);
+	printf("%s)\n{\n", f->nparams ? "" : "void");
+	printf("\tObject *rv = NULL;\n");
+	printf("\tsize_t base = rt_mark();\n");
+	for (v = f->vars; v; v = v->next)
+		if (!v->param)
+			printf("\t%s%s = %s;\n", ctype[v->kind], v->cname, v->kind == K_OBJ ? "NULL" : "0");
+	printf("\n%s", f->code->text ? f->code->text : "");
+	if (f->returns)
+		printf("leave:\n");
+	printf("\trt_release(base);\n");
+	for (v = f->vars; v; v = v->next)
+		if (v->kind == K_OBJ)
+			printf("\trt_drop(%s);\n", v->cname);
+	printf("\treturn rv ? rv : inttype.shared(0);\n}\n\n");
+}
+
+
+/* Write the C code of a module. A module is executed only once.
+ */
+static void write_module(Unit *u)
+{
+	printf("/* %s */\n", u->module->name);
+	printf("static int m_%d(void)\n{\n", u->number);
+	printf("\tstatic bool done = false;\n");
+	printf("\tObject *rv = NULL;\n");
+	printf("\tsize_t base;\n\n");
+	printf("\tif (done)\n\t\treturn 0;\n");
+	printf("\tdone = true;\n");
+	printf("\tbase = rt_mark();\n\n");
+	printf("%s", u->code->text ? u->code->text : "");
+	if (u->returns)
+		printf("leave:\n");
+	printf("\trt_release(base);\n");
+	printf("\treturn rt_exit(rv);\n}\n\n");
+}
+
+
+/* API: Translate a program to C and write the C code to stdout.
+ *
+ * filename     module which contains the main program
+ * library      false: create a program with main()
+ *              true: create a library for the interpreter with
+ *              entry point jit_main(), see jit.c
+ * return       0
+ */
+int compile(const char *filename, bool library)
+{
+	Variable *v;
+	Function *f;
+	Unit *u;
+
+	collect(module.new(filename));
+	resolve();
+
+	for (u = units; u; u = u->next)
+		translate_module(u);
+	for (f = functions; f; f = f->next)
+		translate_function(f);
+
+	printf("/* %s translated to C by %s version %s */\n", filename, LANGUAGE, VERSION);
+	printf("#include <limits.h>\n");
+	printf("#include <math.h>\n");  /* before runtime.h, which defines float_t */
+	printf("#include \"runtime.h\"\n\n");
+	if (library == false)
+		printf("Config config = { .debug = NODEBUG, .tabsize = TABSIZE };\n\n");
+
+	for (v = globals; v; v = v->next)
+		printf("static %s%s = %s;\n", ctype[v->kind], v->cname, v->kind == K_OBJ ? "NULL" : "0");
+	printf("\n");
+
+	for (u = units; u; u = u->next)
+		printf("static int m_%d(void);\n", u->number);
+	for (f = functions; f; f = f->next) {
+		printf("static Object *f_%s(", f->name);
+		for (int i = 0; i < f->nparams; i++)
+			printf("%sObject *", i ? ", " : "");
+		printf("%s);\n", f->nparams ? "" : "void");
+	}
+	printf("\n");
+
+	for (f = functions; f; f = f->next)
+		write_function(f);
+	for (u = units; u; u = u->next)
+		write_module(u);
+
+	if (library == false)
+		printf("int main(void)\n{\n\treturn m_0();\n}\n");
+	else
+		printf("int jit_main(void)\n{\n\treturn m_0();\n}\n");
+
+	return 0;
+}
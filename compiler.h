@@ -0,0 +1,12 @@
+/* compiler.h
+ *
+ * 2020	K.W.E. de Lange
+ */
+#ifndef _COMPILER_
+#define _COMPILER_
+
+#include <stdbool.h>
+
+extern int compile(const char *filename, bool library);
+
+#endif
@@ -0,0 +1,346 @@
+/* deque.c
+ *
+ * Deque object operations
+ *
+ * See deque.h for an explanation of how deques are structured. Removing
+ * the first item of a list (list.remove(0)) is O(1) for the linked list,
+ * but any indexing walks the list. A deque adds and removes items at both
+ * ends in O(1) and finds an item by index in O(1) (see benchmark/deque.x).
+ *
+ * 2020	K.W.E. de Lange
+ */
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "number.h"
+#include "object.h"
+#include "error.h"
+#include "deque.h"
+
+
+/* Create a new empty deque object.
+ */
+static DequeObject *deque_alloc(void)
+{
+	DequeObject *deque;
+
+	if ((deque = calloc(1, sizeof(DequeObject))) == NULL)
+		error(OutOfMemoryError);
+
+	deque->type = DEQUE_T;
+	deque->refcount = 0;
+
+	deque->head = 0;
+	deque->size = 0;
+	deque->capacity = 0;
+	deque->item = NULL;
+
+	return deque;
+}
+
+
+/* Remove all items from a deque and release the objects.
+ */
+static void deque_clear(DequeObject *deque)
+{
+	for (size_t i = 0; i < deque->size; i++)
+		obj_decref(deque->item[deque_slot(deque, i)]);
+
+	deque->head = 0;
+	deque->size = 0;
+}
+
+
+/* Free a deque object, including all referenced objects.
+ */
+static void deque_free(DequeObject *deque)
+{
+	deque_clear(deque);
+	free(deque->item);
+	free(deque);
+}
+
+
+static void deque_print(DequeObject *deque)
+{
+	printf("[");
+
+	for (size_t i = 0; i < deque->size; i++) {
+		obj_print(deque->item[deque_slot(deque, i)]);
+		if (i + 1 < deque->size)
+			printf(",");
+	}
+	printf("]");
+}
+
+
+/* Make room for one more item. When the buffer is full a buffer of twice
+ * the size is allocated, and the items are moved to its start.
+ */
+static void reserve(DequeObject *deque)
+{
+	Object **item;
+	size_t capacity;
+
+	if (deque->size < deque->capacity)
+		return;
+
+	capacity = deque->capacity ? deque->capacity * 2 : 8;
+
+	if ((item = calloc(capacity, sizeof(Object *))) == NULL)
+		error(OutOfMemoryError);
+
+	for (size_t i = 0; i < deque->size; i++)
+		item[i] = deque->item[deque_slot(deque, i)];
+
+	free(deque->item);
+
+	deque->item = item;
+	deque->capacity = capacity;
+	deque->head = 0;
+}
+
+
+/* Add an object at the end of a deque.
+ *
+ * The deque takes over the reference to obj, which must not be a
+ * temporary object, see obj_take().
+ */
+static void deque_append(DequeObject *deque, Object *obj)
+{
+	reserve(deque);
+
+	deque->item[deque_slot(deque, deque->size)] = obj;
+	deque->size++;
+}
+
+
+/* Add an object at the start of a deque.
+ *
+ * The deque takes over the reference to obj, which must not be a
+ * temporary object, see obj_take().
+ */
+static void deque_prepend(DequeObject *deque, Object *obj)
+{
+	reserve(deque);
+
+	deque->head = (deque->head - 1) & (deque->capacity - 1);
+	deque->item[deque->head] = obj;
+	deque->size++;
+}
+
+
+/* Remove the last object from a deque.
+ *
+ * return   object which was removed, NULL if the deque is empty
+ */
+static Object *deque_pop(DequeObject *deque)
+{
+	if (deque->size == 0)
+		return NULL;
+
+	deque->size--;
+
+	return deque->item[deque_slot(deque, deque->size)];
+}
+
+
+/* Remove the first object from a deque.
+ *
+ * return   object which was removed, NULL if the deque is empty
+ */
+static Object *deque_popleft(DequeObject *deque)
+{
+	Object *obj;
+
+	if (deque->size == 0)
+		return NULL;
+
+	obj = deque->item[deque->head];
+	deque->head = deque_slot(deque, 1);
+	deque->size--;
+
+	return obj;
+}
+
+
+/* Retrieve an object from a deque by index. A negative index counts back
+ * from the end of the deque.
+ * Beware: The refcount of the object is increased by 1.
+ *
+ * return   the object, NULL if index is out of range
+ */
+static Object *deque_item(DequeObject *deque, int index)
+{
+	Object *obj;
+
+	if (index < 0)
+		index += (int)deque->size;
+
+	if (index < 0 || (size_t)index >= deque->size)
+		return NULL;  /* IndexError: index out of range */
+
+	obj = deque->item[deque_slot(deque, (size_t)index)];
+	obj_incref(obj);
+
+	return obj;
+}
+
+
+/* Create a new deque from a slice of an existing deque.
+ *
+ * The new deque contains new objects (= deep copy). Start and end are
+ * automatically adjusted to the nearest possible values.
+ */
+static DequeObject *deque_slice(DequeObject *deque, int start, int end)
+{
+	DequeObject *slice;
+	int len = (int)deque->size;
+
+	if (start < 0)
+		start += len;
+
+	if (end < 0)
+		end += len;
+
+	if (start < 0)
+		start = 0;
+
+	if (end >= len)
+		end = len;
+
+	slice = (DequeObject *)obj_alloc(DEQUE_T);
+
+	for (int i = start; i < end; i++)
+		deque_append(slice, obj_promote(obj_copy(deque->item[deque_slot(deque, (size_t)i)])));
+
+	return slice;
+}
+
+
+/* Fill a deque with the items of another deque or of a list.
+ *
+ * The deque contains new objects (= deep copy).
+ */
+static DequeObject *deque_set(DequeObject *dest, Object *src)
+{
+	DequeObject *deque;
+
+	if ((Object *)dest == src)
+		return dest;
+
+	deque_clear(dest);
+
+	if (TYPE(src) == DEQUE_T) {
+		deque = (DequeObject *)src;
+		for (size_t i = 0; i < deque->size; i++)
+			deque_append(dest, obj_promote(obj_copy(deque->item[deque_slot(deque, i)])));
+	} else {
+		ListObject *list = obj_as_list(src);
+
+		for (ListNode *node = list->head; node; node = list_next(list, node))
+			deque_append(dest, obj_promote(obj_copy(node->obj)));
+	}
+
+	return dest;
+}
+
+
+static DequeObject *deque_vset(DequeObject *deque, va_list argp)
+{
+	return deque_set(deque, va_arg(argp, Object *));
+}
+
+
+static int_t size(DequeObject *deque)
+{
+	return (int_t)deque->size;
+}
+
+
+/* Method: deque.append(object)
+ */
+static Object *method_append(Object *deque, Object **argv)
+{
+	deque_append((DequeObject *)deque, obj_take(argv[0]));
+
+	return obj_alloc(NONE_T);
+}
+
+
+/* Method: deque.appendleft(object)
+ */
+static Object *method_appendleft(Object *deque, Object **argv)
+{
+	deque_prepend((DequeObject *)deque, obj_take(argv[0]));
+
+	return obj_alloc(NONE_T);
+}
+
+
+/* Method: deque.pop()
+ */
+static Object *method_pop(Object *deque, Object **argv)
+{
+	Object *obj;
+
+	if ((obj = deque_pop((DequeObject *)deque)) == NULL)
+		error(IndexError);
+
+	return obj;
+}
+
+
+/* Method: deque.popleft()
+ */
+static Object *method_popleft(Object *deque, Object **argv)
+{
+	Object *obj;
+
+	if ((obj = deque_popleft((DequeObject *)deque)) == NULL)
+		error(IndexError);
+
+	return obj;
+}
+
+
+/* Method: deque.len
+ */
+static Object *method_len(Object *deque, Object **argv)
+{
+	return inttype.shared(size((DequeObject *)deque));
+}
+
+
+static Method dequemethod[] = {
+	{"append", method_append, 1},
+	{"appendleft", method_appendleft, 1},
+	{"len", method_len, NOARGLIST},
+	{"pop", method_pop, 0},
+	{"popleft", method_popleft, 0},
+	{NULL}
+};
+
+static MethodTable dequemethods = { .method = dequemethod };
+
+
+/* Deque object API.
+ */
+DequeType dequetype = {
+	.name = "deque",
+	.alloc = (Object *(*)())deque_alloc,
+	.free = (void (*)(Object *))deque_free,
+	.print = (void (*)(Object *))deque_print,
+	.set = (Object *(*)())deque_set,
+	.vset = (Object *(*)(Object *, va_list))deque_vset,
+	.methods = &dequemethods,
+
+	.item = deque_item,
+	.slice = deque_slice,
+	.append = deque_append,
+	.prepend = deque_prepend,
+	.pop = deque_pop,
+	.popleft = deque_popleft,
+
+	.size = size
+	};
@@ -0,0 +1,43 @@
+/* deque.h
+ *
+ * A deque (double-ended queue) stores its items in a ring buffer of object
+ * pointers. The first item is at index 'head' of the buffer, the next items
+ * follow and wrap around at the end of the buffer. The capacity of the
+ * buffer is a power of 2, so an index is wrapped by masking it with
+ * capacity - 1. Adding or removing an item at either end never moves the
+ * other items.
+ *
+ * 2020	K.W.E. de Lange
+ */
+#ifndef _DEQUE_
+#define _DEQUE_
+
+#include "object.h"
+
+typedef struct dequeobject {
+	OBJ_HEAD;
+	size_t head;		/* buffer index of the first item */
+	size_t size;		/* number of items */
+	size_t capacity;	/* number of items allocated, 0 or a power of 2 */
+	Object **item;
+} DequeObject;
+
+/* buffer index of item number i */
+#define deque_slot(deque, i)	(((deque)->head + (i)) & ((deque)->capacity - 1))
+
+typedef struct {
+	TYPE_HEAD;
+	Object *(*item)(DequeObject *deque, int index);
+	DequeObject *(*slice)(DequeObject *deque, int start, int end);
+	void (*append)(DequeObject *deque, Object *obj);
+	void (*prepend)(DequeObject *deque, Object *obj);
+	Object *(*pop)(DequeObject *deque);
+	Object *(*popleft)(DequeObject *deque);
+
+	/* raw versions for internal use, no result object is created */
+	int_t (*size)(DequeObject *deque);
+} DequeType;
+
+extern DequeType dequetype;
+
+#endif
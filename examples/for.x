@@ -1,8 +1,8 @@
-str s = "abc"
-
-print s, '\n'
-
-for c in s
-    c += ' '
-
-print s, '\n'
+str s = "abc"
+
+print s, '\n'
+
+for c in s
+    c += ' '
+
+print s, '\n'
@@ -1,12 +1,12 @@
-# for_in_str.x
-#
-# Loop through characters in string using 'for .. in ..'
-
-str s = "abcdef"
-
-print s
-
-for c in s
-    c += ' '
-
-print s
+# for_in_str.x
+#
+# Loop through characters in string using 'for .. in ..'
+
+str s = "abcdef"
+
+print s
+
+for c in s
+    c += ' '
+
+print s
@@ -1,9 +1,9 @@
-print 1 in [0,1,2]
-
-print 1 in [0,1.1,'a']
-
-print 'b' in "abc"
-
-print 1 in "abc"
-
-print 1 in 2  # error
+print 1 in [0,1,2]
+
+print 1 in [0,1.1,'a']
+
+print 'b' in "abc"
+
+print 1 in "abc"
+
+print 1 in 2  # error
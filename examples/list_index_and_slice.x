@@ -1,44 +1,76 @@
-# Index en slice test on list-object
-#
-# The output should be three times the same
-
-print "Index and slice operations on list constant [\'a\',10,2.1,\"bcd\"]"
-print "[1] =", ['a',10,2.1,"bcd"][1]
-print "[-2] =", ['a',10,2.1,"bcd"][-2]
-print "[:] =", ['a',10,2.1,"bcd"][:]
-print "[1:] =", ['a',10,2.1,"bcd"][1:]
-print "[:3] =", ['a',10,2.1,"bcd"][:3]
-print "[1:3] =", ['a',10,2.1,"bcd"][1:3]
-print "[1:-1] =", ['a',10,2.1,"bcd"][1:-1]
-print "[-1:3] =", ['a',10,2.1,"bcd"][-1:3]
-print "[:][1] =", ['a',10,2.1,"bcd"][:][1]
-print
-
-print "Index and slice operations on list variable l which contains ['a',10,2.1,\"bcd\"]"
-list l = ['a',10,2.1,"bcd"]
-print "[1] =", l[1]
-print "[-2] =", l[-2]
-print "[:] =", l[:]
-print "[1:] =", l[1:]
-print "[:3] =", l[:3]
-print "[1:3] =", l[1:3]
-print "[1:-1] =", l[1:-1]
-print "[-1:3] =", l[-1:3]
-print "[:][1] =", l[:][1]
-print
-
-print "Index and slice operations on function flist() which returns list [\'a\',10,2.1,\"bcd\"]"
-print "flist() =", flist()
-print "[1] =", flist()[1]
-print "[-2] =", flist()[-2]
-print "[:] =", flist()[:]
-print "[1:] =", flist()[1:]
-print "[:3] =", flist()[:3]
-print "[1:3] =", flist()[1:3]
-print "[1:-1] =", flist()[1:-1]
-print "[-1:3] =", flist()[-1:3]
-print "[:][1] =", flist()[:][1]
-print
-
-def flist()
-    return ['a',10,2.1,"bcd"]
+# Index en slice test on list-object
+#
+# The output should be three times the same
+
+print "Index and slice operations on list constant [\'a\',10,2.1,\"bcd\"]"
+print "[1] =", ['a',10,2.1,"bcd"][1]
+print "[-2] =", ['a',10,2.1,"bcd"][-2]
+print "[:] =", ['a',10,2.1,"bcd"][:]
+print "[1:] =", ['a',10,2.1,"bcd"][1:]
+print "[:3] =", ['a',10,2.1,"bcd"][:3]
+print "[1:3] =", ['a',10,2.1,"bcd"][1:3]
+print "[1:-1] =", ['a',10,2.1,"bcd"][1:-1]
+print "[-1:3] =", ['a',10,2.1,"bcd"][-1:3]
+print "[:][1] =", ['a',10,2.1,"bcd"][:][1]
+print
+
+print "Index and slice operations on list variable l which contains ['a',10,2.1,\"bcd\"]"
+list l = ['a',10,2.1,"bcd"]
+print "[1] =", l[1]
+print "[-2] =", l[-2]
+print "[:] =", l[:]
+print "[1:] =", l[1:]
+print "[:3] =", l[:3]
+print "[1:3] =", l[1:3]
+print "[1:-1] =", l[1:-1]
+print "[-1:3] =", l[-1:3]
+print "[:][1] =", l[:][1]
+print
+
+print "Index and slice operations on function flist() which returns list [\'a\',10,2.1,\"bcd\"]"
+print "flist() =", flist()
+print "[1] =", flist()[1]
+print "[-2] =", flist()[-2]
+print "[:] =", flist()[:]
+print "[1:] =", flist()[1:]
+print "[:3] =", flist()[:3]
+print "[1:3] =", flist()[1:3]
+print "[1:-1] =", flist()[1:-1]
+print "[-1:3] =", flist()[-1:3]
+print "[:][1] =", flist()[:][1]
+print
+
+print "Assignment to the loop variable after slice s = l[0:2] of l = [1,2,3] was changed"
+l = [1,2,3]
+list s = l[0:2]
+for x in s
+    s.append(9)
+    x = 100
+    break
+print "s =", s, "l =", l
+print
+
+print "Assignment of row m[0] of matrix m = zeros(2,3) to l[0], then m is changed"
+matrix m = zeros(2, 3)
+l = [0]
+l[0] = m[0]
+m[0][0] = 99
+m = zeros(1, 1)
+print "l =", l
+print
+
+print "Assignment of slice b[3:] of b = [1,2,3,4,5,6] to b[4]"
+list b = [1,2,3,4,5,6]
+b[4] = b[3:]
+print "b =", b
+print
+
+print "Assignment of slice b[:4] of b = [1,2,3] to the loop variable"
+b = [1,2,3]
+for x in b
+    x = b[:4]
+print "b =", b
+print
+
+def flist()
+    return ['a',10,2.1,"bcd"]
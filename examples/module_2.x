@@ -1,13 +1,13 @@
-# module_2.x
-#
-
-print "** now in module_2.x **"
-
-str name = "abracadabra"
-
-import "module_3.x"
-
-def fm2(p)
-    print -raw "call to function fm2(", p, ") in module_2.x\n"
-
-print "** leaving module_2.x **"
+# module_2.x
+#
+
+print "** now in module_2.x **"
+
+str name = "abracadabra"
+
+import "module_3.x"
+
+def fm2(p)
+    print -raw "call to function fm2(", p, ") in module_2.x\n"
+
+print "** leaving module_2.x **"
@@ -1,11 +1,11 @@
-# module_3.x
-#
-
-print "** now in module_3.x **"
-
-import "module_4.x"
-
-def fm3()
-    print "call to function fm3() in module_3.x"
-
-print "** leaving module_3.x **"
+# module_3.x
+#
+
+print "** now in module_3.x **"
+
+import "module_4.x"
+
+def fm3()
+    print "call to function fm3() in module_3.x"
+
+print "** leaving module_3.x **"
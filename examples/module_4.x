@@ -1,11 +1,11 @@
-# module_4.x
-#
-
-print "** now in module_4.x **"
-
-def fm4()
-    print "call to function fm4 in module_4.x"
-
-fm4()
-
-print "** leaving module_4.x **"
+# module_4.x
+#
+
+print "** now in module_4.x **"
+
+def fm4()
+    print "call to function fm4 in module_4.x"
+
+fm4()
+
+print "** leaving module_4.x **"
@@ -1,13 +1,23 @@
-# scope.x
-
-int i = 5
-
-countdown(i)
-
-do
-    print (i += 1)
-while i != 10
-
-def countdown(i)
-    while (i -= 1) >= 0
-        print i
+# scope.x
+
+int i = 5
+
+countdown(i)
+
+do
+    print (i += 1)
+while i != 10
+
+shadow()
+
+def countdown(i)
+    while (i -= 1) >= 0
+        print i
+
+
+# until the declaration of the local i is executed, i is the global i
+#
+def shadow()
+    print i
+    int i = 1
+    print i
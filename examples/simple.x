@@ -1,4 +1,4 @@
-# simple.x
-
-int n = 3
-print n
+# simple.x
+
+int n = 3
+print n
@@ -1,4 +1,4 @@
-for c in ""
-    pass
-
-print -raw ">", c, "< ", type(c)
+for c in ""
+    pass
+
+print -raw ">", c, "< ", type(c)
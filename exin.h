@@ -0,0 +1,71 @@
+/* exin.h
+ *
+ * Interface for native extension modules (see native.c).
+ *
+ * An extension is a shared library written in C. It must export function
+ *
+ *     int exin_init(const ExinAPI *api)
+ *
+ * which is called once when the library is imported. The extension adds
+ * its functions to the builtins with api->builtin() and returns 0, or any
+ * other value if it cannot be used. An extension is not linked with the
+ * interpreter; it can only use the interpreter functions in 'api'. Compile
+ * it with the directory containing the interpreters header files on the
+ * include path, for example
+ *
+ *     cc -std=c99 -O2 -shared -fPIC -I.. sample.c -o sample.so
+ *
+ * A native function receives its arguments as an array of objects. The
+ * number of arguments is checked before the function is called. The
+ * arguments remain owned by the caller. The function must return a new
+ * object, created with one of the api->new_...() functions. If it has no
+ * value to return it returns api->none(). Objects are opaque, their values
+ * are read via the api->as_...() functions which convert to the requested
+ * type or stop the interpreter with an error message. Errors are reported
+ * with api->error() using the codes from error.h; it does not return.
+ *
+ * 2020	K.W.E. de Lange
+ */
+#ifndef _EXIN_
+#define _EXIN_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "config.h"
+#include "error.h"
+
+#define EXIN_API_VERSION	1
+
+#ifndef _OBJECT_
+typedef struct object Object;
+#endif
+
+typedef struct object *(*native_t)(struct object **argv);
+
+typedef struct exinapi {
+	int version;	/* EXIN_API_VERSION of the interpreter */
+
+	void (*builtin)(const char *name, native_t function, int nargs);
+	void (*error)(const int number, ...);
+
+	const char *(*type)(struct object *obj);	/* type name, e.g. "int" */
+	char_t (*as_char)(struct object *obj);
+	int_t (*as_int)(struct object *obj);
+	float_t (*as_float)(struct object *obj);
+	char *(*as_str)(struct object *obj);
+	bool (*as_bool)(struct object *obj);
+	int_t (*length)(struct object *sequence);
+
+	struct object *(*new_char)(char_t c);
+	struct object *(*new_int)(int_t i);
+	struct object *(*new_float)(float_t f);
+	struct object *(*new_str)(const char *s);
+	struct object *(*new_str_n)(const char *s, size_t n);
+	struct object *(*none)(void);
+
+	void (*incref)(struct object *obj);
+	void (*decref)(struct object *obj);
+} ExinAPI;
+
+#endif
@@ -1,524 +1,757 @@
-/* expression.c
- *
- * Expression evaluator
- *
- * Recursively evaluate an expression in the following order:
- *
- * - first variables (including subscripts and slices) and constants,
- *   then function calls, object methods and parenthesized expressions,
- * - then the unary operators + - and !
- * - then multiplication and division (normal and modulo)
- * - then addition and subtraction
- * - then the comparisons < <= > and >=
- * - then the comparisons == and !=
- * - then logical and
- * - then logical or
- * - then assignment of values (normal and compound)
- * - and finally comma separated statements
- *
- * The outcome is an object which contains the result.
- *
- * 1995 K.W.E. de Lange
- */
-#include <limits.h>
-#include <string.h>
-
-#include "expression.h"
-#include "identifier.h"
-#include "position.h"
-#include "function.h"
-#include "scanner.h"
-#include "parser.h"
-#include "error.h"
-#include "str.h"
-
-
-static Object *logical_or_expr(void);
-
-
-/* Decode the next expression and convert the result to an integer.
- *
- * Used when subscript indices must be read.
- */
-static int_t int_expression(void)
-{
-	Object *obj;
-	int_t i;
-
-	obj = logical_or_expr();
-	i = obj_as_int(obj);
-	obj_decref(obj);
-
-	return i;
-}
-
-
-/* Decode subscripts [index] and [start:end] for sequences.
- *
- * Index is mandatory, start and end are optional. The result can be another
- * sequence with subscripts. Decoding continues until no subscripts are left.
- *
- * The opening LSQB of the subscript has already been read.
- *
- * Return: new reference (count = 1)
- *         for LIST: LISTNODE for index or LIST for slice
- *         for STR: CHAR for index or STR for slice
- */
-static Object *subscript(Object *sequence)
-{
-	Object *lvalue, *rvalue, *original = sequence;
-	enum { INDEX, SLICE } type = INDEX;
-	int_t index = 0, start = 0, end = 0;
-
-	if (!isSequence(sequence))
-		error(TypeError, "%s is not subscriptable", TYPENAME(sequence));
-
-	rvalue = sequence;
-
-	while (1) {
-		sequence = isListNode(rvalue) ? obj_from_listnode(rvalue) : rvalue;
-
-		type = INDEX;
-
-		if (accept(COLON)) {
-			start = 0;
-			type = SLICE;
-		} else {
-			start = index = int_expression();
-		}
-		if (accept(COLON)) {
-			type = SLICE;
-		}
-		if (accept(RSQB)) {
-			if (type == SLICE)
-				end = INT_MAX;
-		} else {
-			end = int_expression();
-			expect(RSQB);
-		}
-		if (type == INDEX)
-			lvalue = obj_item((Object *)sequence, index);
-		else
-			lvalue = obj_slice((Object *)sequence, start, end);
-
-		if (lvalue == NULL)
-			error(IndexError);
-
-		if (accept(LSQB)) {
-			if (rvalue != original)
-				obj_decref(rvalue);
-			rvalue = lvalue;
-		} else
-			break;
-	}
-	return lvalue;
-}
-
-
-/* Call methods: seq.len, seq.append, seq.remove, seq.insert
- *
- * The DOT which indicates a method will follow has already been read.
- *
- * Return: new reference (with count = 1)
- */
-static Object *method(Object *object)
-{
-	int_t index;
-	Object *obj = NULL;
-
-	object = isListNode(object) ? obj_from_listnode(object) : object;
-
-	/* If an object has many methods then the approach used below is not
-	 * very efficient and must be rewritten. */
-	if (scanner.token == IDENTIFIER) {
-		if (TYPE(object) == LIST_T && strcmp("insert", scanner.string) == 0) {
-			expect(IDENTIFIER);
-			expect(LPAR);
-			index = int_expression();
-			expect(COMMA);
-			obj = logical_or_expr();
-			listtype.insert((ListObject *)object, index, obj_copy(obj));
-			obj_decref(obj);
-			obj = obj_alloc(NONE_T);
-			expect(RPAR);
-		} else if (TYPE(object) == LIST_T && strcmp("append", scanner.string) == 0) {
-			expect(IDENTIFIER);
-			expect(LPAR);
-			obj = logical_or_expr();
-			listtype.append((ListObject *)object, obj_copy(obj));
-			obj_decref(obj);
-			obj = obj_alloc(NONE_T);
-			expect(RPAR);
-		} else if (TYPE(object) == LIST_T && strcmp("remove", scanner.string) == 0) {
-			expect(IDENTIFIER);
-			expect(LPAR);
-			index = int_expression();
-			if ((obj = listtype.remove((ListObject *)object, index)) == NULL)
-				error(IndexError);
-			expect(RPAR);
-		} else if (TYPE(object) == LIST_T && strcmp("len", scanner.string) == 0) {
-			expect(IDENTIFIER);
-			obj = listtype.length((ListObject *)object);
-		} else if (TYPE(object) == STR_T && strcmp("len", scanner.string) == 0) {
-			expect(IDENTIFIER);
-			obj = strtype.length((StrObject *)object);// str_length((StrObject *)object);
-		} else
-			error(SyntaxError, "unknown method %s for type %s", scanner.string, TYPENAME(object));
-	} else
-		error(SyntaxError, "expected method for type %s", TYPENAME(object));
-
-	return obj;
-}
-
-
-/* Evaluate the part of an expression which comes after the identifier,
- * function call or constant.
- *
- * Contains: subscripts and methods. Methods may follow subscripts:
- * e.g. "abc"[:].len returns 3
- *
- * Return: obj (reference count not increased) if there is no trailer, or
- *         new reference (count = 1)
- */
-static Object *trailer(Object *obj)
-{
-	Object *rv = NULL;
-
-	if (accept(LSQB)) {  /* is subscript */
-		rv = subscript(obj);
-		obj_decref(obj);
-		obj = rv;
-	}
-	if (accept(DOT)) {  /* is method */
-		rv = method(obj);
-		obj_decref(obj);
-	}
-	if (rv == NULL)  /* neither a subscript nor a method */
-		rv = obj;
-
-	return rv;
-}
-
-
-/* Evaluate variables, function calls, constants, (expression)
- *
- * Return: object with reference count +1
- */
-static Object *primary_expr(void)
-{
-	Identifier *id;
-	Object *obj = NULL, *tmp;
-
-	switch (scanner.token) {
-		case CHAR:  /* CHAR constant */
-			obj = obj_create(CHAR_T, str_to_char(scanner.string));
-			expect(CHAR);
-			break;
-		case INT:   /* INT constant */
-			obj = obj_create(INT_T, str_to_int(scanner.string));
-			expect(INT);
-			break;
-		case FLOAT:  /* FLOAT constant */
-			obj = obj_create(FLOAT_T, str_to_float(scanner.string));
-			expect(FLOAT);
-			break;
-		case STR:   /* STR constant */
-			obj = obj_create(STR_T, scanner.string);
-			expect(STR);
-			break;
-		case LSQB:  /* LIST constant */
-			obj = obj_alloc(LIST_T);
-			expect(LSQB);
-			while (accept(RSQB) == 0) {
-				do {
-					tmp = assignment_expr();
-					listtype.append((ListObject *)obj, obj_copy(tmp));
-					obj_decref(tmp);
-				} while (accept(COMMA));
-			}
-			break;
-		case IDENTIFIER:  /* variabele or function identifier */
-			/* precedence rule: user defined identifiers shadow builtins */
-			if ((id = identifier.search(scanner.string)) == NULL) {
-				if ((obj = builtin(scanner.string)) != NULL)
-					break;
-				else
-					error(NameError, "identifier %s is not defined", scanner.string);
-			}
-			expect(IDENTIFIER);
-			if (TYPE(id->object) == POSITION_T) {
-				obj = function_call((PositionObject *)id->object);
-			} else {
-				obj = id->object;
-				obj_incref(obj);
-			}
-			break;
-		case LPAR:  /* parenthesized expression */
-			expect(LPAR);
-			obj = comma_expr();
-			expect(RPAR);
-			break;
-		default:
-			error(SyntaxError, "expression expected");
-	}
-	return trailer(obj);
-}
-
-
-/* Operators: (unary)-  (unary)+  ! (logical negation, NOT)
- */
-static Object *unary_expr(void)
-{
-	Object *lvalue, *result;
-
-	if (accept(NOT)) {
-		result = primary_expr();
-		lvalue = obj_negate(result);
-		obj_decref(result);
-	} else if (accept(MINUS)) {
-		result = primary_expr();
-		lvalue = obj_invert(result);
-		obj_decref(result);
-	} else if (accept(PLUS)) {
-		lvalue = primary_expr();
-	} else
-		lvalue = primary_expr();
-
-	return lvalue;
-}
-
-
-/* Operators: *  /  %
- */
-static Object *mult_expr(void)
-{
-	Object *lvalue, *rvalue, *result;
-
-	lvalue = unary_expr();
-
-	while (1)
-		if (accept(STAR)) {
-			rvalue = unary_expr();
-			result = obj_mult(lvalue, rvalue);
-			obj_decref(lvalue);
-			obj_decref(rvalue);
-			lvalue = result;
-		} else if (accept(SLASH)) {
-			rvalue = unary_expr();
-			result = obj_divs(lvalue, rvalue);
-			obj_decref(lvalue);
-			obj_decref(rvalue);
-			lvalue = result;
-		} else if (accept(PERCENT)) {
-			rvalue = unary_expr();
-			result = obj_mod(lvalue, rvalue);
-			obj_decref(lvalue);
-			obj_decref(rvalue);
-			lvalue = result;
-		} else
-			return lvalue;
-}
-
-
-/* Operators: +  -
- */
-static Object *additive_expr(void)
-{
-	Object *lvalue, *rvalue, *result;
-
-	lvalue = mult_expr();
-
-	while (1)
-		if (accept(PLUS)) {
-			rvalue = mult_expr();
-			result = obj_add(lvalue, rvalue);
-			obj_decref(lvalue);
-			obj_decref(rvalue);
-			lvalue = result;
-		} else if (accept(MINUS)) {
-			rvalue = mult_expr();
-			result = obj_sub(lvalue, rvalue);
-			obj_decref(lvalue);
-			obj_decref(rvalue);
-			lvalue = result;
-		} else
-			return lvalue;
-}
-
-
-/* Operators: <  <=  >  >=
- */
-static Object *relational_expr(void)
-{
-	Object *lvalue, *rvalue, *result;
-
-	lvalue = additive_expr();
-
-	while (1)
-		if (accept(LESS)) {
-			rvalue = relational_expr();
-			result = obj_lss(lvalue, rvalue);
-			obj_decref(lvalue);
-			obj_decref(rvalue);
-			lvalue = result;
-		} else if (accept(LESSEQUAL)) {
-			rvalue = relational_expr();
-			result = obj_leq(lvalue, rvalue);
-			obj_decref(lvalue);
-			obj_decref(rvalue);
-			lvalue = result;
-		} else if (accept(GREATER)) {
-			rvalue = relational_expr();
-			result = obj_gtr(lvalue, rvalue);
-			obj_decref(lvalue);
-			obj_decref(rvalue);
-			lvalue = result;
-		} else if (accept(GREATEREQUAL)) {
-			rvalue = relational_expr();
-			result = obj_geq(lvalue, rvalue);
-			obj_decref(lvalue);
-			obj_decref(rvalue);
-			lvalue = result;
-		} else
-			return lvalue;
-}
-
-
-/* Operators: ==  !=  <>  in
- */
-static Object *equality_expr(void)
-{
-	Object *lvalue, *rvalue, *result;
-
-	lvalue = relational_expr();
-
-	while (1)
-		if (accept(EQEQUAL)) {
-			rvalue = equality_expr();
-			result = obj_eql(lvalue, rvalue);
-			obj_decref(lvalue);
-			obj_decref(rvalue);
-			lvalue = result;
-		} else if (accept(NOTEQUAL)) {
-			rvalue = equality_expr();
-			result = obj_neq(lvalue, rvalue);
-			obj_decref(lvalue);
-			obj_decref(rvalue);
-			lvalue = result;
-		} else if (accept(IN)) {
-			rvalue = equality_expr();
-			result = obj_in(lvalue, rvalue);
-			obj_decref(lvalue);
-			obj_decref(rvalue);
-			lvalue = result;
-		} else
-			return lvalue;
-}
-
-
-/* Operators: logical and
- */
-static Object *logical_and_expr(void)
-{
-	Object *lvalue, *rvalue, *result;
-
-	lvalue = equality_expr();
-
-	while (1)
-		if (accept(AND)) {
-			rvalue = logical_and_expr();
-			result= obj_and(lvalue, rvalue);
-			obj_decref(lvalue);
-			obj_decref(rvalue);
-			lvalue = result;
-		} else
-			return lvalue;
-}
-
-
-/* Operators: logical or
- */
-static Object *logical_or_expr(void)
-{
-	Object *lvalue, *rvalue, *result;
-
-	lvalue = logical_and_expr();
-
-	while (1)
-		if (accept(OR)) {
-			rvalue = logical_or_expr();
-			result = obj_or(lvalue, rvalue);
-			obj_decref(lvalue);
-			obj_decref(rvalue);
-			lvalue = result;
-		} else
-			return lvalue;
-}
-
-
-/* Operators: =  +=  -=  *=  /=  %=
- */
-Object *assignment_expr(void)
-{
-	Object *lvalue, *rvalue, *result;
-
-	lvalue = logical_or_expr();
-
-	while (1)
-		if (accept(EQUAL)) {
-			rvalue = assignment_expr();
-			obj_assign(lvalue, rvalue);
-			obj_decref(rvalue);
-		} else if (accept(PLUSEQUAL)) {
-			rvalue = logical_or_expr();
-			result = obj_add(lvalue, rvalue);
-			obj_assign(lvalue, result);
-			obj_decref(rvalue);
-			obj_decref(result);
-		} else if (accept(MINUSEQUAL)) {
-			rvalue = logical_or_expr();
-			result = obj_sub(lvalue, rvalue);
-			obj_assign(lvalue, result);
-			obj_decref(rvalue);
-			obj_decref(result);
-		} else if (accept(STAREQUAL)) {
-			rvalue = logical_or_expr();
-			result = obj_mult(lvalue, rvalue);
-			obj_assign(lvalue, result);
-			obj_decref(rvalue);
-			obj_decref(result);
-		} else if (accept(SLASHEQUAL)) {
-			rvalue = logical_or_expr();
-			result = obj_divs(lvalue, rvalue);
-			obj_assign(lvalue, result);
-			obj_decref(rvalue);
-			obj_decref(result);
-		} else if (accept(PERCENTEQUAL)) {
-			rvalue = logical_or_expr();
-			result = obj_mod(lvalue, rvalue);
-			obj_assign(lvalue, result);
-			obj_decref(rvalue);
-			obj_decref(result);
-		} else
-			return lvalue;
-}
-
-
-/* Operators: ,
- *
- * Multiple expressions separated by comma's. Returns an object with the
- * result from the last expression.
- */
-Object *comma_expr(void)
-{
-	Object *lvalue;
-
-	lvalue = assignment_expr();
-
-	while (1)
-		if (accept(COMMA)) {
-			obj_decref(lvalue);
-			lvalue = comma_expr();
-		} else
-			return lvalue;
-}
+/* expression.c
+ *
+ * Expression evaluator
+ *
+ * Recursively evaluate an expression in the following order:
+ *
+ * - first variables (including subscripts and slices) and constants,
+ *   then function calls, object methods and parenthesized expressions,
+ * - then the unary operators + - ! and ~
+ * - then multiplication and division (normal and modulo)
+ * - then addition and subtraction
+ * - then the bitwise shifts << and >>
+ * - then bitwise and, xor and or (in this order)
+ * - then the comparisons < <= > and >=
+ * - then the comparisons == and !=
+ * - then logical and
+ * - then logical or
+ * - then assignment of values (normal and compound)
+ * - and finally comma separated statements
+ *
+ * The outcome is an object which contains the result.
+ *
+ * 1995 K.W.E. de Lange
+ */
+#include <limits.h>
+#include <string.h>
+
+#include "expression.h"
+#include "identifier.h"
+#include "position.h"
+#include "reader.h"
+#include "function.h"
+#include "scanner.h"
+#include "parser.h"
+#include "error.h"
+#include "str.h"
+#include "matrix.h"
+#include "bytes.h"
+
+
+static Object *logical_or_expr(void);
+static Object *(*compound(token_t t))(Object *, Object *);
+
+
+/* Read an index which is just an integer literal or a numeric variable
+ * directly, without evaluating it as an expression.
+ *
+ * i        pointer to variable which receives the index
+ * return   true if successful, false if the index must be evaluated as an
+ *          expression (the current token is then unchanged)
+ */
+static bool int_operand(int_t *i)
+{
+	char text[BUFSIZE + 1];
+	Identifier *id;
+
+	if (scanner.token == INT)
+		*i = str_to_int(scanner.string);
+	else if (scanner.token == IDENTIFIER && (id = identifier_lookup(scanner.string, reader.pos)) != NULL \
+			 && isNumber(identifier.get(id)))
+		*i = obj_as_int(id->object);
+	else
+		return false;
+
+	strcpy(text, scanner.string);
+
+	switch (scanner_peek()) {
+		case RSQB: case COLON: case COMMA: case RPAR:
+			scanner_next();
+			return true;
+		default:
+			strcpy(scanner.string, text);  /* peek() overwrote scanner.string */
+			return false;
+	}
+}
+
+
+/* Decode the next expression and convert the result to an integer.
+ *
+ * Used when subscript indices must be read.
+ */
+static int_t int_expression(void)
+{
+	Object *obj;
+	int_t i;
+
+	if (int_operand(&i))
+		return i;
+
+	obj = logical_or_expr();
+	i = obj_as_int(obj);
+	obj_decref(obj);
+
+	return i;
+}
+
+
+/* Assign a value to element 'index' of a row view of a matrix or of a
+ * bytes object.
+ *
+ * The element itself is not an object but a float in the matrix data or a
+ * byte, so the assignment is handled here instead of in assignment_expr().
+ * For bytes lvalue is a shared integer which is not modified, the byte is
+ * returned as a shared integer so no object is created.
+ *
+ * in:  token = EQUAL or compound assignment
+ * out: token = first token after the assigned expression
+ *
+ * Return: lvalue containing the assigned value
+ */
+static Object *element_assignment(Object *sequence, int_t index, Object *lvalue)
+{
+	Object *(*operator)(Object *, Object *);
+	Object *rvalue, *result;
+	int_t value;
+
+	if (accept(EQUAL)) {
+		result = assignment_expr();
+	} else {
+		operator = compound(scanner.token);
+		scanner_next();
+		rvalue = logical_or_expr();
+		result = operator(lvalue, rvalue);
+		obj_decref(rvalue);
+	}
+
+	if (isBytes(sequence)) {
+		value = obj_as_int(result);
+		obj_decref(result);
+		if (bytestype.store((BytesObject *)sequence, (int)index, value) == false)
+			error(IndexError);
+		obj_decref(lvalue);
+		return inttype.shared(value);
+	}
+
+	obj_assign(lvalue, result);
+	obj_decref(result);
+
+	if (matrixtype.store((MatrixObject *)sequence, index, obj_as_float(lvalue)) == false)
+		error(IndexError);
+
+	return lvalue;
+}
+
+
+/* Decode subscripts [index] and [start:end] for sequences.
+ *
+ * Index is mandatory, start and end are optional. The result can be another
+ * sequence with subscripts. Decoding continues until no subscripts are left.
+ *
+ * The opening LSQB of the subscript has already been read.
+ *
+ * Return: new reference (count = 1)
+ *         for LIST: LISTNODE for index or LIST for slice
+ *         for STR: CHAR for index or STR for slice
+ *         for DEQUE: item for index or DEQUE for slice
+ *         for MATRIX: row view for index, for a row view FLOAT for index
+ *         for BYTES: INT for index or BYTES for slice
+ */
+static Object *subscript(Object *sequence)
+{
+	Object *lvalue, *rvalue, *original = sequence;
+	enum { INDEX, SLICE } type = INDEX;
+	int_t index = 0, start = 0, end = 0;
+
+	if (!isSequence(sequence))
+		error(TypeError, "%s is not subscriptable", TYPENAME(sequence));
+
+	rvalue = sequence;
+
+	while (1) {
+		sequence = isListNode(rvalue) ? obj_from_listnode(rvalue) : rvalue;
+
+		type = INDEX;
+
+		if (accept(COLON)) {
+			start = 0;
+			type = SLICE;
+		} else {
+			start = index = int_expression();
+		}
+		if (accept(COLON)) {
+			type = SLICE;
+		}
+		if (accept(RSQB)) {
+			if (type == SLICE)
+				end = INT_MAX;
+		} else {
+			end = int_expression();
+			expect(RSQB);
+		}
+		if (type == INDEX)
+			lvalue = obj_item((Object *)sequence, index);
+		else
+			lvalue = obj_slice((Object *)sequence, start, end);
+
+		if (lvalue == NULL)
+			error(IndexError);
+
+		if (accept(LSQB)) {
+			if (rvalue != original)
+				obj_decref(rvalue);
+			rvalue = lvalue;
+		} else
+			break;
+	}
+	if (type == INDEX && isMatrix(sequence) && (sequence->flags & OBJ_VIEW)) {
+		if (scanner.token == EQUAL || compound(scanner.token))
+			lvalue = element_assignment(sequence, index, lvalue);
+		if (rvalue != original)
+			obj_decref(rvalue);  /* the row view is no longer needed */
+	} else if (type == INDEX && isBytes(sequence)) {
+		if (scanner.token == EQUAL || compound(scanner.token))
+			lvalue = element_assignment(sequence, index, lvalue);
+	}
+	return lvalue;
+}
+
+
+/* Call methods, e.g. seq.len, list.append(obj)
+ *
+ * The DOT which indicates a method will follow has already been read. The
+ * methods of a type are found in its method table, see obj_method().
+ *
+ * Return: new reference (with count = 1)
+ */
+static Object *method(Object *object)
+{
+	Object *argv[MAXARGS];
+	int argc = 0;
+	Method *m;
+
+	object = isListNode(object) ? obj_from_listnode(object) : object;
+
+	if (scanner.token != IDENTIFIER)
+		error(SyntaxError, "expected method for type %s", TYPENAME(object));
+
+	if ((m = obj_method(TYPE(object), scanner.string)) == NULL)
+		error(SyntaxError, "unknown method %s for type %s", scanner.string, TYPENAME(object));
+
+	expect(IDENTIFIER);
+
+	if (m->nargs != NOARGLIST) {
+		expect(LPAR);
+		while (scanner.token != RPAR && argc < m->nargs) {
+			argv[argc++] = logical_or_expr();
+			if (!accept(COMMA))
+				break;
+		}
+		if (argc != m->nargs || scanner.token != RPAR)
+			error(TypeError, "%s() takes %d argument(s)", m->name, m->nargs);
+		expect(RPAR);
+	}
+
+	return m->function(object, argv);
+}
+
+
+/* Evaluate the part of an expression which comes after the identifier,
+ * function call or constant.
+ *
+ * Contains: subscripts and methods. Methods may follow subscripts:
+ * e.g. "abc"[:].len returns 3
+ *
+ * Return: obj (reference count not increased) if there is no trailer, or
+ *         new reference (count = 1)
+ */
+static Object *trailer(Object *obj)
+{
+	Object *rv = NULL;
+
+	if (accept(LSQB)) {  /* is subscript */
+		rv = subscript(obj);
+		obj_decref(obj);
+		obj = rv;
+	}
+	if (accept(DOT)) {  /* is method */
+		rv = method(obj);
+		obj_decref(obj);
+	}
+	if (rv == NULL)  /* neither a subscript nor a method */
+		rv = obj;
+
+	return rv;
+}
+
+
+/* Evaluate variables, function calls, constants, (expression)
+ *
+ * Return: object with reference count +1
+ */
+static Object *primary_expr(void)
+{
+	Identifier *id;
+	Object *obj = NULL, *tmp;
+
+	switch (scanner.token) {
+		case CHAR:  /* CHAR constant */
+			obj = chartype.shared(str_to_char(scanner.string));
+			expect(CHAR);
+			break;
+		case INT:   /* INT constant */
+			obj = int_from_str(scanner.string);
+			expect(INT);
+			break;
+		case FLOAT:  /* FLOAT constant */
+			obj = obj_new_float(str_to_float(scanner.string));
+			expect(FLOAT);
+			break;
+		case STR:   /* STR constant */
+			obj = obj_new_str(scanner.string);
+			expect(STR);
+			break;
+		case LSQB:  /* LIST constant */
+			obj = obj_alloc(LIST_T);
+			expect(LSQB);
+			while (accept(RSQB) == 0) {
+				do {
+					tmp = assignment_expr();
+					listtype.append((ListObject *)obj, obj_take(tmp));
+				} while (accept(COMMA));
+			}
+			break;
+		case IDENTIFIER:  /* variabele or function identifier */
+			/* precedence rule: user defined identifiers shadow builtins */
+			if ((id = identifier_lookup(scanner.string, reader.pos)) == NULL) {
+				if ((obj = builtin(scanner.string)) != NULL)
+					break;
+				else
+					error(NameError, "identifier %s is not defined", scanner.string);
+			}
+			expect(IDENTIFIER);
+			if (TYPE(obj = identifier.get(id)) == POSITION_T)
+				obj = function_call((PositionObject *)obj);
+			else
+				obj_incref(obj);
+			break;
+		case LPAR:  /* parenthesized expression */
+			expect(LPAR);
+			obj = comma_expr();
+			expect(RPAR);
+			break;
+		default:
+			error(SyntaxError, "expression expected");
+	}
+	return trailer(obj);
+}
+
+
+/* Operators: (unary)-  (unary)+  ! (logical negation, NOT)  ~ (complement)
+ */
+static Object *unary_expr(void)
+{
+	Object *lvalue, *result;
+
+	if (accept(NOT)) {
+		result = primary_expr();
+		lvalue = obj_negate(result);
+		obj_decref(result);
+	} else if (accept(TILDE)) {
+		result = primary_expr();
+		lvalue = obj_complement(result);
+		obj_decref(result);
+	} else if (accept(MINUS)) {
+		result = primary_expr();
+		lvalue = obj_invert(result);
+		obj_decref(result);
+	} else if (accept(PLUS)) {
+		lvalue = primary_expr();
+	} else
+		lvalue = primary_expr();
+
+	return lvalue;
+}
+
+
+/* Operators: *  /  %
+ */
+static Object *mult_expr(void)
+{
+	Object *lvalue, *rvalue, *result;
+
+	lvalue = unary_expr();
+
+	while (1)
+		if (accept(STAR)) {
+			rvalue = unary_expr();
+			result = obj_mult(lvalue, rvalue);
+			obj_decref(lvalue);
+			obj_decref(rvalue);
+			lvalue = result;
+		} else if (accept(SLASH)) {
+			rvalue = unary_expr();
+			result = obj_divs(lvalue, rvalue);
+			obj_decref(lvalue);
+			obj_decref(rvalue);
+			lvalue = result;
+		} else if (accept(PERCENT)) {
+			rvalue = unary_expr();
+			result = obj_mod(lvalue, rvalue);
+			obj_decref(lvalue);
+			obj_decref(rvalue);
+			lvalue = result;
+		} else
+			return lvalue;
+}
+
+
+/* Operators: +  -
+ */
+static Object *additive_expr(void)
+{
+	Object *lvalue, *rvalue, *result;
+
+	lvalue = mult_expr();
+
+	while (1)
+		if (accept(PLUS)) {
+			rvalue = mult_expr();
+			result = obj_add(lvalue, rvalue);
+			obj_decref(lvalue);
+			obj_decref(rvalue);
+			lvalue = result;
+		} else if (accept(MINUS)) {
+			rvalue = mult_expr();
+			result = obj_sub(lvalue, rvalue);
+			obj_decref(lvalue);
+			obj_decref(rvalue);
+			lvalue = result;
+		} else
+			return lvalue;
+}
+
+
+/* Operators: <<  >>
+ */
+static Object *shift_expr(void)
+{
+	Object *lvalue, *rvalue, *result;
+
+	lvalue = additive_expr();
+
+	while (1)
+		if (accept(LEFTSHIFT)) {
+			rvalue = additive_expr();
+			result = obj_lshift(lvalue, rvalue);
+			obj_decref(lvalue);
+			obj_decref(rvalue);
+			lvalue = result;
+		} else if (accept(RIGHTSHIFT)) {
+			rvalue = additive_expr();
+			result = obj_rshift(lvalue, rvalue);
+			obj_decref(lvalue);
+			obj_decref(rvalue);
+			lvalue = result;
+		} else
+			return lvalue;
+}
+
+
+/* Operators: &
+ */
+static Object *bitand_expr(void)
+{
+	Object *lvalue, *rvalue, *result;
+
+	lvalue = shift_expr();
+
+	while (accept(AMPER)) {
+		rvalue = shift_expr();
+		result = obj_bitand(lvalue, rvalue);
+		obj_decref(lvalue);
+		obj_decref(rvalue);
+		lvalue = result;
+	}
+	return lvalue;
+}
+
+
+/* Operators: ^
+ */
+static Object *bitxor_expr(void)
+{
+	Object *lvalue, *rvalue, *result;
+
+	lvalue = bitand_expr();
+
+	while (accept(CIRCUMFLEX)) {
+		rvalue = bitand_expr();
+		result = obj_bitxor(lvalue, rvalue);
+		obj_decref(lvalue);
+		obj_decref(rvalue);
+		lvalue = result;
+	}
+	return lvalue;
+}
+
+
+/* Operators: |
+ */
+static Object *bitor_expr(void)
+{
+	Object *lvalue, *rvalue, *result;
+
+	lvalue = bitxor_expr();
+
+	while (accept(VBAR)) {
+		rvalue = bitxor_expr();
+		result = obj_bitor(lvalue, rvalue);
+		obj_decref(lvalue);
+		obj_decref(rvalue);
+		lvalue = result;
+	}
+	return lvalue;
+}
+
+
+/* Operators: <  <=  >  >=
+ */
+static Object *relational_expr(void)
+{
+	Object *lvalue, *rvalue, *result;
+
+	lvalue = bitor_expr();
+
+	while (1)
+		if (accept(LESS)) {
+			rvalue = relational_expr();
+			result = obj_lss(lvalue, rvalue);
+			obj_decref(lvalue);
+			obj_decref(rvalue);
+			lvalue = result;
+		} else if (accept(LESSEQUAL)) {
+			rvalue = relational_expr();
+			result = obj_leq(lvalue, rvalue);
+			obj_decref(lvalue);
+			obj_decref(rvalue);
+			lvalue = result;
+		} else if (accept(GREATER)) {
+			rvalue = relational_expr();
+			result = obj_gtr(lvalue, rvalue);
+			obj_decref(lvalue);
+			obj_decref(rvalue);
+			lvalue = result;
+		} else if (accept(GREATEREQUAL)) {
+			rvalue = relational_expr();
+			result = obj_geq(lvalue, rvalue);
+			obj_decref(lvalue);
+			obj_decref(rvalue);
+			lvalue = result;
+		} else
+			return lvalue;
+}
+
+
+/* Operators: ==  !=  <>  in
+ */
+static Object *equality_expr(void)
+{
+	Object *lvalue, *rvalue, *result;
+
+	lvalue = relational_expr();
+
+	while (1)
+		if (accept(EQEQUAL)) {
+			rvalue = equality_expr();
+			result = obj_eql(lvalue, rvalue);
+			obj_decref(lvalue);
+			obj_decref(rvalue);
+			lvalue = result;
+		} else if (accept(NOTEQUAL)) {
+			rvalue = equality_expr();
+			result = obj_neq(lvalue, rvalue);
+			obj_decref(lvalue);
+			obj_decref(rvalue);
+			lvalue = result;
+		} else if (accept(IN)) {
+			rvalue = equality_expr();
+			result = obj_in(lvalue, rvalue);
+			obj_decref(lvalue);
+			obj_decref(rvalue);
+			lvalue = result;
+		} else
+			return lvalue;
+}
+
+
+/* Return the operator function of compound assignment token t, or NULL if
+ * t is not a compound assignment.
+ */
+static Object *(*compound(token_t t))(Object *, Object *)
+{
+	switch (t) {
+		case PLUSEQUAL: return obj_add;
+		case MINUSEQUAL: return obj_sub;
+		case STAREQUAL: return obj_mult;
+		case SLASHEQUAL: return obj_divs;
+		case PERCENTEQUAL: return obj_mod;
+		case AMPEREQUAL: return obj_bitand;
+		case VBAREQUAL: return obj_bitor;
+		case CIRCUMFLEXEQUAL: return obj_bitxor;
+		case LEFTSHIFTEQUAL: return obj_lshift;
+		case RIGHTSHIFTEQUAL: return obj_rshift;
+		default: return NULL;
+	}
+}
+
+
+/* Skip the right operand of logical operator 'op' without evaluating it.
+ *
+ * Tokens are read until one is found which - outside of any parentheses or
+ * brackets - cannot be part of the operand. As 'and' takes precedence over
+ * 'or' the right operand of 'and' also ends at 'or'.
+ *
+ * in:  token = first token of the operand
+ * out: token = first token after the operand
+ */
+static void skip_operand(token_t op)
+{
+	int depth = 0;
+
+	while (1) {
+		switch (scanner.token) {
+			case LPAR:
+			case LSQB:
+				depth++;
+				break;
+			case RPAR:
+			case RSQB:
+				if (depth == 0)
+					return;
+				depth--;
+				break;
+			case OR:
+				if (depth == 0 && op == AND)
+					return;
+				break;
+			case NEWLINE: case ENDMARKER:
+				return;
+			case COMMA: case COLON:
+				if (depth == 0)
+					return;
+				break;
+			default:
+				if (depth == 0 && (scanner.token == EQUAL || compound(scanner.token)))
+					return;
+				break;
+		}
+		scanner_next();
+	}
+}
+
+
+/* Operators: logical and
+ */
+static Object *logical_and_expr(void)
+{
+	Object *lvalue, *rvalue, *result;
+
+	lvalue = equality_expr();
+
+	while (1)
+		if (accept(AND)) {
+			if (isNumber(isListNode(lvalue) ? obj_from_listnode(lvalue) : lvalue) \
+				&& !obj_as_bool(lvalue)) {
+				skip_operand(AND);  /* result is 0 whatever the right operand is */
+				obj_decref(lvalue);
+				return inttype.shared(0);
+			}
+			rvalue = logical_and_expr();
+			result= obj_and(lvalue, rvalue);
+			obj_decref(lvalue);
+			obj_decref(rvalue);
+			lvalue = result;
+		} else
+			return lvalue;
+}
+
+
+/* Operators: logical or
+ */
+static Object *logical_or_expr(void)
+{
+	Object *lvalue, *rvalue, *result;
+
+	lvalue = logical_and_expr();
+
+	while (1)
+		if (accept(OR)) {
+			if (isNumber(isListNode(lvalue) ? obj_from_listnode(lvalue) : lvalue) \
+				&& obj_as_bool(lvalue)) {
+				skip_operand(OR);  /* result is 1 whatever the right operand is */
+				obj_decref(lvalue);
+				return inttype.shared(1);
+			}
+			rvalue = logical_or_expr();
+			result = obj_or(lvalue, rvalue);
+			obj_decref(lvalue);
+			obj_decref(rvalue);
+			lvalue = result;
+		} else
+			return lvalue;
+}
+
+
+/* Operators: =  +=  -=  *=  /=  %=  &=  |=  ^=  <<=  >>=
+ */
+Object *assignment_expr(void)
+{
+	Object *(*operator)(Object *, Object *);
+	Object *lvalue, *rvalue, *result;
+
+	lvalue = logical_or_expr();
+
+	/* shared objects may not be modified, so assign to a private copy */
+	if ((lvalue->flags & OBJ_SHARED) && TYPE(lvalue) != NONE_T)
+		if (scanner.token == EQUAL || compound(scanner.token)) {
+			result = obj_copy(lvalue);
+			obj_decref(lvalue);
+			lvalue = result;
+		}
+
+	while (1)
+		if (accept(EQUAL)) {
+			rvalue = assignment_expr();
+			obj_assign(lvalue, rvalue);
+			obj_decref(rvalue);
+		} else if ((operator = compound(scanner.token)) != NULL) {
+			scanner_next();
+			rvalue = logical_or_expr();
+			result = operator(lvalue, rvalue);
+			obj_assign(lvalue, result);
+			obj_decref(rvalue);
+			obj_decref(result);
+		} else
+			return lvalue;
+}
+
+
+/* Operators: ,
+ *
+ * Multiple expressions separated by comma's. Returns an object with the
+ * result from the last expression.
+ */
+Object *comma_expr(void)
+{
+	Object *lvalue;
+
+	lvalue = assignment_expr();
+
+	while (1)
+		if (accept(COMMA)) {
+			obj_decref(lvalue);
+			lvalue = comma_expr();
+		} else
+			return lvalue;
+}
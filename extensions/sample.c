@@ -0,0 +1,101 @@
+/* sample.c
+ *
+ * Sample native extension module. It adds three builtins:
+ *
+ *     fib(n)       n-th Fibonacci number
+ *     gcd(a, b)    greatest common divisor of integers a and b
+ *     upper(s)     string s in upper case
+ *
+ * Build (from this directory):
+ *     cc -std=c99 -O2 -shared -fPIC -I.. sample.c -o sample.so
+ * or on Windows:
+ *     gcc -std=c99 -O2 -shared -I.. sample.c -o sample.dll
+ *
+ * and run sample.x with:
+ *     exin sample.x
+ *
+ * 2020	K.W.E. de Lange
+ */
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "exin.h"
+
+#if defined(_WIN32)
+#define EXPORT	__declspec(dllexport)
+#else
+#define EXPORT
+#endif
+
+static const ExinAPI *api;
+
+
+/* Syntax: fib(integer expression)
+ */
+static Object *fib(Object **argv)
+{
+	int_t n = api->as_int(argv[0]), a = 0, b = 1, t;
+
+	if (n < 0)
+		api->error(ValueError, "fib() argument must be >= 0");
+
+	while (n--) {
+		t = a + b;
+		a = b;
+		b = t;
+	}
+	return api->new_int(a);
+}
+
+
+/* Syntax: gcd(integer expression, integer expression)
+ */
+static Object *gcd(Object **argv)
+{
+	int_t a = labs(api->as_int(argv[0])), b = labs(api->as_int(argv[1])), t;
+
+	while (b) {
+		t = a % b;
+		a = b;
+		b = t;
+	}
+	return api->new_int(a);
+}
+
+
+/* Syntax: upper(string expression)
+ */
+static Object *upper(Object **argv)
+{
+	const char *s = api->as_str(argv[0]);
+	size_t len = strlen(s);
+	Object *obj;
+	char *u;
+
+	if ((u = malloc(len + 1)) == NULL)
+		api->error(OutOfMemoryError);
+
+	for (size_t i = 0; i <= len; i++)
+		u[i] = (char)toupper((unsigned char)s[i]);
+
+	obj = api->new_str_n(u, len);
+	free(u);
+
+	return obj;
+}
+
+
+EXPORT int exin_init(const ExinAPI *exin)
+{
+	if (exin->version != EXIN_API_VERSION)
+		return 1;
+
+	api = exin;
+
+	api->builtin("fib", fib, 1);
+	api->builtin("gcd", gcd, 2);
+	api->builtin("upper", upper, 1);
+
+	return 0;
+}
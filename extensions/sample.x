@@ -0,0 +1,17 @@
+# sample.x
+
+# Use the functions from native extension module sample.so, see sample.c
+#
+
+import "sample.so"
+
+print fib(50)
+print gcd(84, 36)
+print upper("hello world")
+
+int i = 0
+list l = []
+while i < 10
+    l += [fib(i)]
+    i += 1
+print l
@@ -1,125 +1,797 @@
-/* function.c
- *
- * Builtin (aka intrinsic) functions.
- *
- * 2019	K.W.E. de Lange
- */
-#include <string.h>
-#include "error.h"
-#include "function.h"
-
-
-/* Builtin: determine the type of an expression
- *
- * in:	token = LPAR of argument list
- * out:	token = token after RPAR of function call argument list
- *
- * Syntax: type(expression)
- */
-static Object *type(void)
-{
-	Object *obj, *result;
-
-	expect(LPAR);
-	obj = assignment_expr();
-	expect(RPAR);
-
-	result = isListNode(obj) ? obj_type(obj_from_listnode(obj)) : obj_type(obj);
-
-	obj_decref(obj);
-
-	return result;
-}
-
-
-/* Builtin: return ASCII character (as string) representation of integer
- *
- * in:	token = LPAR of argument list
- * out:	token = token after RPAR of function call argument list
- *
- * Syntax: chr(integer expression)
- */
-static Object *chr(void)
-{
-	Object *obj, *result;
-	char buffer[BUFSIZE+1];
-
-	expect(LPAR);
-	obj = assignment_expr();
-	expect(RPAR);
-
-	snprintf(buffer, BUFSIZE, "%c", obj_as_char(obj));
-	result = obj_create(STR_T, buffer);
-
-	obj_decref(obj);
-
-	return result;
-}
-
-
-/* Builtin: return integer representation of ASCII character (in string)
- *
- * in:	token = LPAR of argument list
- * out:	token = token after RPAR of function call argument list
- *
- * Syntaxt: ord(string expression)
- */
-static Object *ord(void)
-{
-	Object *obj, *result;
-
-	expect(LPAR);
-	obj = assignment_expr();
-	expect(RPAR);
-
-	if (TYPE(obj) != STR_T)
-		error(TypeError, "expected string but found %s", TYPENAME(obj));
-
-	result = obj_create(INT_T, (int_t)obj_as_char(obj));
-	obj_decref(obj);
-
-	return result;
-}
-
-
-/*	Table containing all builtin function names and their addresses.
- */
-static struct {
-	char *functionname;
-	Object *(*functionaddr)();
-} builtinTable[] = { /* Note: functionnames must be sorted alphabetically */
-	{"chr", chr},
-	{"ord", ord},
-	{"type", type}
-};
-
-
-/* Check if functionname is an builtin function, and if so execute it.
- *
- * functionname	identifier to check for builtin function
- * return		Object* with function results if functionname
- * 				was a builtin else NULL
- */
-Object *builtin(char *functionname)
-{
-	int l, h, m, d;
-
-	l = 0, h = (int)(sizeof builtinTable / sizeof builtinTable[0]) - 1;
-
-	while (l <= h) {
-		m = (l + h) / 2;
-		d = strcmp(&functionname[0], builtinTable[m].functionname);
-		if (d < 0)
-			h = m - 1;
-		if (d > 0)
-			l = m + 1;
-		if (d == 0)
-			break;
-	};
-
-	if (d == 0) {
-		expect(IDENTIFIER);
-		return builtinTable[m].functionaddr();  /* call */
-	} else
-		return NULL;
-}
+/* function.c
+ *
+ * Builtin (aka intrinsic) functions.
+ *
+ * A builtin receives its arguments as an array of already evaluated
+ * objects. In this way builtins can be called from the interpreter, which
+ * evaluates the argument list itself (see builtin()), but also from code
+ * translated to C (see builtin_call()).
+ *
+ * Next to the builtins in builtinTable functions from native extension
+ * modules can be added while the program runs, see builtin_register() and
+ * native.c.
+ *
+ * 2019	K.W.E. de Lange
+ */
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "strdup.h"
+#include "bignum.h"
+#include "number.h"
+#include "arena.h"
+#include "error.h"
+#include "function.h"
+#include "rng.h"
+#include "matrix.h"
+#include "regexp.h"
+
+
+/* Builtin: determine the type of an expression
+ *
+ * Syntax: type(expression)
+ */
+static Object *type(Object **argv)
+{
+	Object *obj = argv[0];
+
+	return isListNode(obj) ? obj_type(obj_from_listnode(obj)) : obj_type(obj);
+}
+
+
+/* Builtin: return ASCII character (as string) representation of integer
+ *
+ * Syntax: chr(integer expression)
+ */
+static Object *chr(Object **argv)
+{
+	char buffer[BUFSIZE+1];
+
+	snprintf(buffer, BUFSIZE, "%c", obj_as_char(argv[0]));
+
+	return obj_new_str(buffer);
+}
+
+
+/* Builtin: return integer representation of ASCII character (in string)
+ *
+ * Syntaxt: ord(string expression)
+ */
+static Object *ord(Object **argv)
+{
+	Object *obj = argv[0];
+
+	if (TYPE(obj) != STR_T)
+		error(TypeError, "expected string but found %s", TYPENAME(obj));
+
+	return obj_new_int((int_t)obj_as_char(obj));
+}
+
+
+/* Raw versions of the math builtins. Translated code calls these directly
+ * when the arguments are C variables (see builtin_expr() in compiler.c).
+ */
+float_t math_sqrt(float_t x)
+{
+	if (x < 0)
+		error(ValueError, "math domain error in sqrt(%G)", x);
+
+	return sqrt(x);
+}
+
+
+float_t math_log(float_t x)
+{
+	if (x <= 0)
+		error(ValueError, "math domain error in log(%G)", x);
+
+	return log(x);
+}
+
+
+/* Integer power. A negative exponent gives the same result as integer
+ * division 1 / x ** -y would.
+ *
+ * return   false if the result does not fit in an int_t, else true and the
+ *          result in *r
+ */
+static bool ipow(int_t x, int_t y, int_t *r)
+{
+	*r = 1;
+
+	if (y < 0) {
+		if (x == 0)
+			error(DivisionByZeroError);
+		*r = x == 1 ? 1 : x == -1 ? (y % 2 ? -1 : 1) : 0;
+		return true;
+	}
+
+	while (y) {  /* exponentiation by squaring */
+		if (y & 1)
+			if (int_mul_overflow(*r, x, r))
+				return false;
+		if ((y >>= 1) != 0)
+			if (int_mul_overflow(x, x, &x))
+				return false;
+	}
+	return true;
+}
+
+
+/* Translated code keeps integers in C variables, which cannot hold a
+ * bignum. An overflow is therefore an error there.
+ */
+int_t math_ipow(int_t x, int_t y)
+{
+	int_t r;
+
+	if (!ipow(x, y, &r))
+		error(ValueError, "integer overflow in pow(%ld, %ld)", x, y);
+
+	return r;
+}
+
+
+int_t math_iabs(int_t x)
+{
+	return x < 0 ? -x : x;
+}
+
+
+int_t math_imin(int_t x, int_t y)
+{
+	return x < y ? x : y;
+}
+
+
+int_t math_imax(int_t x, int_t y)
+{
+	return x > y ? x : y;
+}
+
+
+float_t math_fmin(float_t x, float_t y)
+{
+	return x < y ? x : y;
+}
+
+
+float_t math_fmax(float_t x, float_t y)
+{
+	return x > y ? x : y;
+}
+
+
+/* Check that obj is a number and return its type. Obj may be a listnode
+ * which refers to a number.
+ */
+static objecttype_t number(Object *obj)
+{
+	obj = isListNode(obj) ? obj_from_listnode(obj) : obj;
+
+	if (!isNumber(obj))
+		error(TypeError, "expected number but found %s", TYPENAME(obj));
+
+	return TYPE(obj);
+}
+
+
+/* Determine the type of the result of a math builtin with two arguments,
+ * according to the same rules as arithmetic operations (see coerce() in
+ * number.c): FLOAT if at least one argument is FLOAT, else INTEGER if at
+ * least one argument is INTEGER, else CHAR.
+ */
+static objecttype_t coerce(Object *op1, Object *op2)
+{
+	objecttype_t t1 = number(op1), t2 = number(op2);
+
+	if (t1 == FLOAT_T || t2 == FLOAT_T)
+		return FLOAT_T;
+	else if (t1 == INT_T || t2 == INT_T)
+		return INT_T;
+	else
+		return CHAR_T;
+}
+
+
+/* Create a new number of type 'type' with integer value i.
+ */
+static Object *new_integer(objecttype_t type, int_t i)
+{
+	return type == CHAR_T ? obj_new_char((char_t)i) : obj_new_int(i);
+}
+
+
+/* Check if obj is an integer which is too large for an int_t. Obj may be
+ * a listnode which refers to a number.
+ */
+static bool big(Object *obj)
+{
+	obj = isListNode(obj) ? obj_from_listnode(obj) : obj;
+
+	return isBigInt(obj);
+}
+
+
+/* Return a copy of x if compare(x, y) is true, else a copy of y.
+ */
+static Object *choose(Object *(*compare)(Object *, Object *), Object *x, Object *y)
+{
+	Object *result, *obj;
+
+	result = compare(x, y);
+	obj = obj_copy(obj_as_bool(result) ? x : y);
+	obj_decref(result);
+
+	return obj;
+}
+
+
+/* Builtin: x to the power y
+ *
+ * Syntax: pow(number, number)
+ */
+static Object *builtin_pow(Object **argv)
+{
+	objecttype_t type = coerce(argv[0], argv[1]);
+	Object *x = isListNode(argv[0]) ? obj_from_listnode(argv[0]) : argv[0];
+	int_t y, r;
+	Bignum *b;
+
+	if (type == FLOAT_T)
+		return obj_new_float(pow(obj_as_float(argv[0]), obj_as_float(argv[1])));
+
+	y = obj_as_int(argv[1]);
+
+	if (!isBigInt(x) && ipow(obj_as_int(x), y, &r))
+		return new_integer(type, r);
+
+	if (y < 0)  /* |x| > 1 */
+		return obj_new_int(0);
+
+	b = isBigInt(x) ? bignum_copy(((IntObject *)x)->big) : bignum_from_int(obj_as_int(x));
+	x = int_from_bignum(bignum_pow(b, (unsigned long)y));
+	bignum_free(b);
+
+	return x;
+}
+
+
+/* Builtin: smallest of two numbers
+ *
+ * Syntax: min(number, number)
+ */
+static Object *builtin_min(Object **argv)
+{
+	objecttype_t type = coerce(argv[0], argv[1]);
+
+	if (type == FLOAT_T)
+		return obj_new_float(math_fmin(obj_as_float(argv[0]), obj_as_float(argv[1])));
+
+	if (big(argv[0]) || big(argv[1]))
+		return choose(obj_lss, argv[0], argv[1]);
+
+	return new_integer(type, math_imin(obj_as_int(argv[0]), obj_as_int(argv[1])));
+}
+
+
+/* Builtin: largest of two numbers
+ *
+ * Syntax: max(number, number)
+ */
+static Object *builtin_max(Object **argv)
+{
+	objecttype_t type = coerce(argv[0], argv[1]);
+
+	if (type == FLOAT_T)
+		return obj_new_float(math_fmax(obj_as_float(argv[0]), obj_as_float(argv[1])));
+
+	if (big(argv[0]) || big(argv[1]))
+		return choose(obj_gtr, argv[0], argv[1]);
+
+	return new_integer(type, math_imax(obj_as_int(argv[0]), obj_as_int(argv[1])));
+}
+
+
+/* Builtin: absolute value, of the same type as the argument
+ *
+ * Syntax: abs(number)
+ */
+static Object *builtin_abs(Object **argv)
+{
+	objecttype_t type = number(argv[0]);
+
+	if (type == FLOAT_T)
+		return obj_new_float(fabs(obj_as_float(argv[0])));
+
+	if (big(argv[0]) || (type == INT_T && obj_as_int(argv[0]) == LONG_MIN))
+		return obj_as_float(argv[0]) < 0 ? obj_invert(argv[0]) : obj_copy(argv[0]);
+
+	return new_integer(type, math_iabs(obj_as_int(argv[0])));
+}
+
+
+/* Builtin: round down respectively up to a whole number. The result has
+ * the same type as the argument.
+ *
+ * Syntax: floor(number), ceil(number)
+ */
+static Object *builtin_floor(Object **argv)
+{
+	objecttype_t type = number(argv[0]);
+
+	if (type == FLOAT_T)
+		return obj_new_float(floor(obj_as_float(argv[0])));
+
+	if (big(argv[0]))
+		return obj_copy(argv[0]);
+
+	return new_integer(type, obj_as_int(argv[0]));
+}
+
+
+static Object *builtin_ceil(Object **argv)
+{
+	objecttype_t type = number(argv[0]);
+
+	if (type == FLOAT_T)
+		return obj_new_float(ceil(obj_as_float(argv[0])));
+
+	if (big(argv[0]))
+		return obj_copy(argv[0]);
+
+	return new_integer(type, obj_as_int(argv[0]));
+}
+
+
+/* Builtins: square root, e to the power x, natural logarithm, sine and
+ * cosine (in radians). The result is always a float.
+ *
+ * Syntax: sqrt(number), exp(number), log(number), sin(number), cos(number)
+ */
+static Object *builtin_sqrt(Object **argv)
+{
+	number(argv[0]);
+	return obj_new_float(math_sqrt(obj_as_float(argv[0])));
+}
+
+
+static Object *builtin_exp(Object **argv)
+{
+	number(argv[0]);
+	return obj_new_float(exp(obj_as_float(argv[0])));
+}
+
+
+static Object *builtin_log(Object **argv)
+{
+	number(argv[0]);
+	return obj_new_float(math_log(obj_as_float(argv[0])));
+}
+
+
+static Object *builtin_sin(Object **argv)
+{
+	number(argv[0]);
+	return obj_new_float(sin(obj_as_float(argv[0])));
+}
+
+
+static Object *builtin_cos(Object **argv)
+{
+	number(argv[0]);
+	return obj_new_float(cos(obj_as_float(argv[0])));
+}
+
+
+/* The random number generator of the random builtins. Unless seed() is
+ * called it is seeded from the time and an address, which differs per
+ * process if address space layout randomization is used. So interpreters
+ * which are started at the same time each get their own sequence.
+ */
+static Generator generator;
+static bool seeded = false;
+
+
+static Generator *random_generator(void)
+{
+	if (seeded == false) {
+		rng_seed(&generator, (uint64_t)time(NULL) ^ (uint64_t)clock() ^ (uint64_t)(uintptr_t)&generator);
+		seeded = true;
+	}
+	return &generator;
+}
+
+
+/* Raw versions of random() and randint(), for translated code.
+ */
+float_t math_random(void)
+{
+	return rng_float(random_generator());
+}
+
+
+int_t math_randint(int_t a, int_t b)
+{
+	if (a > b)
+		error(ValueError, "empty range for randint(%ld, %ld)", (long)a, (long)b);
+
+	return rng_range(random_generator(), a, b);
+}
+
+
+/* Builtin: random float in the range [0, 1)
+ *
+ * Syntax: random()
+ */
+static Object *builtin_random(Object **argv)
+{
+	return obj_new_float(math_random());
+}
+
+
+/* Builtin: random integer in the range [a, b], including b
+ *
+ * Syntax: randint(integer expression, integer expression)
+ */
+static Object *builtin_randint(Object **argv)
+{
+	return obj_new_int(math_randint(obj_as_int(argv[0]), obj_as_int(argv[1])));
+}
+
+
+/* Builtin: list with n random floats in the range [0, 1)
+ *
+ * Syntax: randlist(integer expression)
+ */
+static Object *builtin_randlist(Object **argv)
+{
+	Generator *g = random_generator();
+	int_t n = obj_as_int(argv[0]);
+	Object *list;
+
+	if (n < 0)
+		error(ValueError, "randlist() argument must be >= 0");
+
+	list = obj_alloc(LIST_T);
+
+	arena.suspend();  /* the numbers are stored in the list */
+	while (n--)
+		listtype.append((ListObject *)list, obj_new_float(rng_float(g)));
+	arena.resume();
+
+	return list;
+}
+
+
+/* Builtin: restart the random number generator, the same seed always
+ * gives the same sequence of numbers
+ *
+ * Syntax: seed(integer expression)
+ */
+static Object *builtin_seed(Object **argv)
+{
+	rng_seed(&generator, (uint64_t)obj_as_int(argv[0]));
+	seeded = true;
+
+	return obj_alloc(NONE_T);
+}
+
+
+/* Builtin: matrix with all elements 0
+ *
+ * Syntax: zeros(integer expression, integer expression)
+ */
+static Object *builtin_zeros(Object **argv)
+{
+	int_t rows = obj_as_int(argv[0]), cols = obj_as_int(argv[1]);
+
+	if (rows < 0 || cols < 0)
+		error(ValueError, "zeros() arguments must be >= 0");
+
+	return (Object *)matrixtype.create((size_t)rows, (size_t)cols);
+}
+
+
+/* Builtin: n x n identity matrix
+ *
+ * Syntax: identity(integer expression)
+ */
+static Object *builtin_identity(Object **argv)
+{
+	int_t n = obj_as_int(argv[0]);
+	MatrixObject *m;
+
+	if (n < 0)
+		error(ValueError, "identity() argument must be >= 0");
+
+	m = matrixtype.create((size_t)n, (size_t)n);
+
+	for (int_t i = 0; i < n; i++)
+		m->data[i * n + i] = 1;
+
+	return (Object *)m;
+}
+
+
+/* Builtin: check if the whole string matches a regular expression (see
+ * regexp.c for the syntax)
+ *
+ * Syntax: match(pattern, string)
+ */
+static Object *builtin_match(Object **argv)
+{
+	const char *s = obj_as_str(argv[1]);
+
+	return inttype.shared(regexp_match(regexp_compile(obj_as_str(argv[0])), s, strlen(s)));
+}
+
+
+/* Builtin: index of the first match of a regular expression in a string,
+ * -1 if there is none
+ *
+ * Syntax: search(pattern, string)
+ */
+static Object *builtin_search(Object **argv)
+{
+	const char *s = obj_as_str(argv[1]);
+	RegexpMatch m;
+
+	if (regexp_search(regexp_compile(obj_as_str(argv[0])), s, strlen(s), &m) == false)
+		return inttype.shared(-1);
+
+	return obj_new_int((int_t)m.start);
+}
+
+
+/* Builtin: list with all non-overlapping matches of a regular expression
+ * in a string
+ *
+ * Syntax: findall(pattern, string)
+ */
+static Object *builtin_findall(Object **argv)
+{
+	const char *s = obj_as_str(argv[1]);
+	RegexpMatch *m;
+	Object *list;
+	size_t n;
+
+	n = regexp_findall(regexp_compile(obj_as_str(argv[0])), s, strlen(s), &m);
+
+	list = obj_alloc(LIST_T);
+
+	arena.suspend();  /* the strings are stored in the list */
+	for (size_t i = 0; i < n; i++)
+		listtype.append((ListObject *)list, obj_new_str_n(s + m[i].start, m[i].end - m[i].start));
+	arena.resume();
+
+	free(m);
+
+	return list;
+}
+
+
+/* Builtin: replace all non-overlapping matches of a regular expression in
+ * a string by another string
+ *
+ * Syntax: sub(pattern, replacement, string)
+ */
+static Object *builtin_sub(Object **argv)
+{
+	const char *r = obj_as_str(argv[1]), *s = obj_as_str(argv[2]);
+	size_t n, len = strlen(s), rlen = strlen(r), size = len, from = 0;
+	RegexpMatch *m;
+	Object *result;
+	char *buffer, *p;
+
+	n = regexp_findall(regexp_compile(obj_as_str(argv[0])), s, len, &m);
+
+	if (n == 0)
+		return obj_new_str(s);
+
+	for (size_t i = 0; i < n; i++)
+		size += rlen - (m[i].end - m[i].start);
+
+	if ((p = buffer = malloc(size + 1)) == NULL)
+		error(OutOfMemoryError);
+
+	for (size_t i = 0; i < n; i++) {
+		memcpy(p, s + from, m[i].start - from);
+		p += m[i].start - from;
+		memcpy(p, r, rlen);
+		p += rlen;
+		from = m[i].end;
+	}
+	memcpy(p, s + from, len - from);
+
+	result = obj_new_str_n(buffer, size);
+
+	free(buffer);
+	free(m);
+
+	return result;
+}
+
+
+/*	Table containing all builtin function names, their addresses and the
+ *	number of arguments they expect.
+ */
+typedef struct {
+	char *functionname;
+	Object *(*functionaddr)(Object **argv);
+	int nargs;
+} Builtin;
+
+static Builtin builtinTable[] = { /* Note: functionnames must be sorted alphabetically */
+	{"abs", builtin_abs, 1},
+	{"ceil", builtin_ceil, 1},
+	{"chr", chr, 1},
+	{"cos", builtin_cos, 1},
+	{"exp", builtin_exp, 1},
+	{"findall", builtin_findall, 2},
+	{"floor", builtin_floor, 1},
+	{"identity", builtin_identity, 1},
+	{"log", builtin_log, 1},
+	{"match", builtin_match, 2},
+	{"max", builtin_max, 2},
+	{"min", builtin_min, 2},
+	{"ord", ord, 1},
+	{"pow", builtin_pow, 2},
+	{"randint", builtin_randint, 2},
+	{"randlist", builtin_randlist, 1},
+	{"random", builtin_random, 0},
+	{"search", builtin_search, 2},
+	{"seed", builtin_seed, 1},
+	{"sin", builtin_sin, 1},
+	{"sqrt", builtin_sqrt, 1},
+	{"sub", builtin_sub, 3},
+	{"type", type, 1},
+	{"zeros", builtin_zeros, 2}
+};
+
+/*	The builtins in use. Initially builtinTable, when functions are added
+ *	a larger copy (still sorted alphabetically).
+ */
+static Builtin *table = builtinTable;
+static int entries = sizeof builtinTable / sizeof builtinTable[0];
+
+
+/* Search functionname in the table with builtins.
+ *
+ * return	index in table or -1 if not found
+ */
+static int search(const char *functionname)
+{
+	int l, h, m, d;
+
+	l = 0, h = entries - 1;
+
+	while (l <= h) {
+		m = (l + h) / 2;
+		d = strcmp(functionname, table[m].functionname);
+		if (d < 0)
+			h = m - 1;
+		if (d > 0)
+			l = m + 1;
+		if (d == 0)
+			return m;
+	};
+
+	return -1;
+}
+
+
+/* Check the number of arguments and call builtin number m.
+ */
+static Object *call(int m, int argc, Object **argv)
+{
+	if (argc != table[m].nargs)
+		error(TypeError, "%s() takes %d argument(s) but %d were given", \
+						 table[m].functionname, table[m].nargs, argc);
+
+	return table[m].functionaddr(argv);
+}
+
+
+/* Add a builtin function.
+ *
+ * functionname	name of the builtin
+ * functionaddr	function to call, see builtinTable
+ * nargs		number of arguments the function expects
+ */
+void builtin_register(const char *functionname, Object *(*functionaddr)(Object **argv), int nargs)
+{
+	Builtin *t;
+	int m;
+
+	if (search(functionname) != -1)
+		error(NameError, "builtin %s is already defined", functionname);
+	if (nargs < 0 || nargs > MAXARGS)
+		error(ValueError, "builtin %s cannot take %d arguments", functionname, nargs);
+
+	if ((t = malloc((entries + 1) * sizeof(Builtin))) == NULL)
+		error(OutOfMemoryError);
+
+	for (m = 0; m < entries && strcmp(table[m].functionname, functionname) < 0; m++)
+		;
+
+	memcpy(t, table, m * sizeof(Builtin));
+	memcpy(t + m + 1, table + m, (entries - m) * sizeof(Builtin));
+
+	if ((t[m].functionname = strdup(functionname)) == NULL)
+		error(OutOfMemoryError);
+	t[m].functionaddr = functionaddr;
+	t[m].nargs = nargs;
+
+	if (table != builtinTable)
+		free(table);
+
+	table = t;
+	entries++;
+}
+
+
+/* Check if functionname is a builtin function.
+ */
+bool isbuiltin(const char *functionname)
+{
+	return search(functionname) != -1;
+}
+
+
+/* Call a builtin function with already evaluated arguments.
+ *
+ * functionname	name of the builtin
+ * argc			number of arguments
+ * argv			array with arguments, these remain owned by the caller
+ * return		Object* with function results (new reference)
+ */
+Object *builtin_call(const char *functionname, int argc, Object **argv)
+{
+	int m;
+
+	if ((m = search(functionname)) == -1)
+		error(NameError, "identifier %s is not defined", functionname);
+
+	return call(m, argc, argv);
+}
+
+
+/* Check if functionname is an builtin function, and if so execute it.
+ *
+ * functionname	identifier to check for builtin function
+ * return		Object* with function results if functionname
+ * 				was a builtin else NULL
+ *
+ * in:	token = IDENTIFIER of the builtin
+ * out:	token = token after RPAR of function call argument list
+ */
+Object *builtin(char *functionname)
+{
+	int m, argc = 0;
+	Object *argv[MAXARGS], *result;
+
+	if ((m = search(functionname)) == -1)
+		return NULL;
+
+	expect(IDENTIFIER);
+	expect(LPAR);
+
+	while (scanner.token != RPAR) {
+		if (argc == MAXARGS)
+			error(SyntaxError, "too many arguments for %s()", table[m].functionname);
+		argv[argc++] = assignment_expr();
+		if (!accept(COMMA))
+			break;
+	}
+	expect(RPAR);
+
+	result = call(m, argc, argv);
+
+	while (argc--)
+		obj_decref(argv[argc]);
+
+	return result;
+}
@@ -1,13 +1,28 @@
-/* function.h
- *
- * 2019	K.W.E. de Lange
- */
-#ifndef _FUNCTION_
-#define _FUNCTION_
-
-#include "expression.h"
-#include "parser.h"
-
-Object *builtin(char *functionname);
-
-#endif
+/* function.h
+ *
+ * 2019	K.W.E. de Lange
+ */
+#ifndef _FUNCTION_
+#define _FUNCTION_
+
+#include "expression.h"
+#include "parser.h"
+
+Object *builtin(char *functionname);
+Object *builtin_call(const char *functionname, int argc, Object **argv);
+bool isbuiltin(const char *functionname);
+/* raw versions of the math builtins, for translated code */
+float_t math_sqrt(float_t x);
+float_t math_log(float_t x);
+int_t math_ipow(int_t x, int_t y);
+int_t math_iabs(int_t x);
+int_t math_imin(int_t x, int_t y);
+int_t math_imax(int_t x, int_t y);
+float_t math_fmin(float_t x, float_t y);
+float_t math_fmax(float_t x, float_t y);
+float_t math_random(void);
+int_t math_randint(int_t a, int_t b);
+
+void builtin_register(const char *functionname, Object *(*functionaddr)(Object **argv), int nargs);
+
+#endif
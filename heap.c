@@ -0,0 +1,372 @@
+/* heap.c
+ *
+ * Heap (priority queue) object operations
+ *
+ * See heap.h for an explanation of how heaps are structured. Pushing and
+ * popping an entry take O(log n) comparisons, instead of the O(n) it takes
+ * to keep a list sorted with list.insert() (see benchmark/heap.x).
+ *
+ * 2020	K.W.E. de Lange
+ */
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "number.h"
+#include "object.h"
+#include "error.h"
+#include "heap.h"
+
+#define key(e)	((e).priority ? (e).priority : (e).item)
+
+
+/* Create a new empty heap object.
+ */
+static HeapObject *heap_alloc(void)
+{
+	HeapObject *heap;
+
+	if ((heap = calloc(1, sizeof(HeapObject))) == NULL)
+		error(OutOfMemoryError);
+
+	heap->type = HEAP_T;
+	heap->refcount = 0;
+
+	heap->size = 0;
+	heap->capacity = 0;
+	heap->entry = NULL;
+
+	return heap;
+}
+
+
+/* Remove all entries from a heap and release the objects they reference.
+ */
+static void heap_clear(HeapObject *heap)
+{
+	while (heap->size) {
+		heap->size--;
+		if (heap->entry[heap->size].priority)
+			obj_decref(heap->entry[heap->size].priority);
+		obj_decref(heap->entry[heap->size].item);
+	}
+}
+
+
+/* Free a heap object, including all referenced objects.
+ */
+static void heap_free(HeapObject *heap)
+{
+	heap_clear(heap);
+	free(heap->entry);
+	free(heap);
+}
+
+
+/* Print the items of a heap in the order in which they are stored. The
+ * first item is the smallest, the others are not sorted.
+ */
+static void heap_print(HeapObject *heap)
+{
+	printf("[");
+
+	for (size_t i = 0; i < heap->size; i++) {
+		obj_print(heap->entry[i].item);
+		if (i + 1 < heap->size)
+			printf(",");
+	}
+	printf("]");
+}
+
+
+/* Make room for at least n entries.
+ */
+static void reserve(HeapObject *heap, size_t n)
+{
+	HeapEntry *entry;
+	size_t capacity;
+
+	if (n <= heap->capacity)
+		return;
+
+	capacity = heap->capacity ? heap->capacity : 8;
+	while (capacity < n)
+		capacity *= 2;
+
+	if ((entry = realloc(heap->entry, capacity * sizeof(HeapEntry))) == NULL)
+		error(OutOfMemoryError);
+
+	heap->entry = entry;
+	heap->capacity = capacity;
+}
+
+
+/* Compare two priorities.
+ *
+ * Integers and floats are compared directly; all other combinations
+ * are compared by obj_lss() and thus follow the rules of operator <.
+ */
+static bool less(Object *op1, Object *op2)
+{
+	Object *result;
+	bool b;
+
+	if (TYPE(op1) == INT_T && TYPE(op2) == INT_T && !isBigInt(op1) && !isBigInt(op2))
+		return ((IntObject *)op1)->ival < ((IntObject *)op2)->ival;
+	if (TYPE(op1) == FLOAT_T && TYPE(op2) == FLOAT_T)
+		return ((FloatObject *)op1)->fval < ((FloatObject *)op2)->fval;
+
+	result = obj_lss(op1, op2);
+	b = obj_as_bool(result);
+	obj_decref(result);
+
+	return b;
+}
+
+
+/* Move the entry at index i up until its parent is not larger.
+ */
+static void sift_up(HeapObject *heap, size_t i)
+{
+	HeapEntry e = heap->entry[i];
+	size_t parent;
+
+	while (i > 0) {
+		parent = (i - 1) / 2;
+		if (!less(key(e), key(heap->entry[parent])))
+			break;
+		heap->entry[i] = heap->entry[parent];
+		i = parent;
+	}
+	heap->entry[i] = e;
+}
+
+
+/* Move the entry at index i down until none of its children is smaller.
+ */
+static void sift_down(HeapObject *heap, size_t i)
+{
+	HeapEntry e = heap->entry[i];
+	size_t child;
+
+	while ((child = 2 * i + 1) < heap->size) {
+		if (child + 1 < heap->size && less(key(heap->entry[child + 1]), key(heap->entry[child])))
+			child++;
+		if (!less(key(heap->entry[child]), key(e)))
+			break;
+		heap->entry[i] = heap->entry[child];
+		i = child;
+	}
+	heap->entry[i] = e;
+}
+
+
+/* Add an item to a heap.
+ *
+ * heap     heap to add the item to
+ * priority priority of the item, NULL to order by the item itself
+ * item     item to add
+ *
+ * The heap takes over the references to priority and item. These must
+ * not be temporary objects, see obj_take().
+ */
+static void heap_push(HeapObject *heap, Object *priority, Object *item)
+{
+	reserve(heap, heap->size + 1);
+
+	heap->entry[heap->size].priority = priority;
+	heap->entry[heap->size].item = item;
+
+	sift_up(heap, heap->size++);
+}
+
+
+/* Remove the item with the smallest priority from a heap.
+ *
+ * return   the removed item, NULL if the heap is empty
+ */
+static Object *heap_pop(HeapObject *heap)
+{
+	Object *item;
+
+	if (heap->size == 0)
+		return NULL;
+
+	if (heap->entry[0].priority)
+		obj_decref(heap->entry[0].priority);
+	item = heap->entry[0].item;
+
+	if (--heap->size) {
+		heap->entry[0] = heap->entry[heap->size];
+		sift_down(heap, 0);
+	}
+	return item;
+}
+
+
+/* Fill a heap with the content of another heap or with the items of a list.
+ *
+ * The heap contains new objects (= deep copy). The items of a list are
+ * ordered in O(n) by sifting down every entry which has children.
+ */
+static HeapObject *heap_set(HeapObject *dest, Object *src)
+{
+	HeapObject *heap;
+	HeapEntry *e;
+
+	if ((Object *)dest == src)
+		return dest;
+
+	heap_clear(dest);
+
+	if (TYPE(src) == HEAP_T) {
+		heap = (HeapObject *)src;
+		reserve(dest, heap->size);
+		for (e = heap->entry; e < heap->entry + heap->size; e++, dest->size++) {
+			dest->entry[dest->size].priority = e->priority ? obj_promote(obj_copy(e->priority)) : NULL;
+			dest->entry[dest->size].item = obj_promote(obj_copy(e->item));
+		}
+	} else {
+		ListObject *list = obj_as_list(src);
+
+		for (ListNode *node = list->head; node; node = list_next(list, node)) {
+			reserve(dest, dest->size + 1);
+			dest->entry[dest->size].priority = NULL;
+			dest->entry[dest->size++].item = obj_promote(obj_copy(node->obj));
+		}
+		for (size_t i = dest->size / 2; i-- > 0; )
+			sift_down(dest, i);
+	}
+	return dest;
+}
+
+
+static HeapObject *heap_vset(HeapObject *heap, va_list argp)
+{
+	return heap_set(heap, va_arg(argp, Object *));
+}
+
+
+static int_t size(HeapObject *heap)
+{
+	return (int_t)heap->size;
+}
+
+
+/* Method: heap.push(item)
+ */
+static Object *method_push(Object *heap, Object **argv)
+{
+	heap_push((HeapObject *)heap, NULL, obj_take(argv[0]));
+
+	return obj_alloc(NONE_T);
+}
+
+
+/* Method: heap.put(priority, item)
+ */
+static Object *method_put(Object *heap, Object **argv)
+{
+	Object *priority = isListNode(argv[0]) ? obj_from_listnode(argv[0]) : argv[0];
+
+	if (!isNumber(priority))
+		error(TypeError, "priority must be a number, not %s", TYPENAME(priority));
+
+	heap_push((HeapObject *)heap, obj_take(argv[0]), obj_take(argv[1]));
+
+	return obj_alloc(NONE_T);
+}
+
+
+/* Method: heap.pop()
+ */
+static Object *method_pop(Object *heap, Object **argv)
+{
+	Object *item;
+
+	if ((item = heap_pop((HeapObject *)heap)) == NULL)
+		error(IndexError);
+
+	return item;
+}
+
+
+/* Method: heap.peek()
+ */
+static Object *method_peek(Object *heap, Object **argv)
+{
+	Object *item;
+
+	if (((HeapObject *)heap)->size == 0)
+		error(IndexError);
+
+	item = ((HeapObject *)heap)->entry[0].item;
+	obj_incref(item);
+
+	return item;
+}
+
+
+/* Method: heap.pushpop(item)
+ *
+ * Push item and then pop the smallest item, in a single sift. If item is
+ * not larger than the smallest item it is returned right away. A heap of
+ * the k largest values seen is kept up to date with k pushes followed by
+ * one pushpop per value, which is O(n log k) for n values.
+ */
+static Object *method_pushpop(Object *heap, Object **argv)
+{
+	HeapObject *h = (HeapObject *)heap;
+	Object *item = obj_take(argv[0]), *smallest;
+
+	if (h->size == 0 || !less(key(h->entry[0]), item))
+		return item;
+
+	if (h->entry[0].priority) {
+		obj_decref(h->entry[0].priority);
+		h->entry[0].priority = NULL;
+	}
+	smallest = h->entry[0].item;
+	h->entry[0].item = item;
+	sift_down(h, 0);
+
+	return smallest;
+}
+
+
+/* Method: heap.len
+ */
+static Object *method_len(Object *heap, Object **argv)
+{
+	return inttype.shared(size((HeapObject *)heap));
+}
+
+
+static Method heapmethod[] = {
+	{"len", method_len, NOARGLIST},
+	{"peek", method_peek, 0},
+	{"pop", method_pop, 0},
+	{"push", method_push, 1},
+	{"pushpop", method_pushpop, 1},
+	{"put", method_put, 2},
+	{NULL}
+};
+
+static MethodTable heapmethods = { .method = heapmethod };
+
+
+/* Heap object API.
+ */
+HeapType heaptype = {
+	.name = "heap",
+	.alloc = (Object *(*)())heap_alloc,
+	.free = (void (*)(Object *))heap_free,
+	.print = (void (*)(Object *))heap_print,
+	.set = (Object *(*)())heap_set,
+	.vset = (Object *(*)(Object *, va_list))heap_vset,
+	.methods = &heapmethods,
+
+	.push = heap_push,
+	.pop = heap_pop,
+
+	.size = size
+	};
@@ -0,0 +1,39 @@
+/* heap.h
+ *
+ * A heap is a priority queue. Its entries are kept in a contiguous array
+ * which is ordered as a binary min-heap: the entry at index i is never
+ * larger than the entries at index 2i+1 and 2i+2, so the smallest entry is
+ * always at index 0. An entry is ordered by its priority, or if it was
+ * pushed without priority by the item itself.
+ *
+ * 2020	K.W.E. de Lange
+ */
+#ifndef _HEAP_
+#define _HEAP_
+
+#include "object.h"
+
+typedef struct heapentry {
+	Object *priority;	/* NULL if the item is its own priority */
+	Object *item;
+} HeapEntry;
+
+typedef struct heapobject {
+	OBJ_HEAD;
+	size_t size;		/* number of entries in use */
+	size_t capacity;	/* number of entries allocated */
+	HeapEntry *entry;
+} HeapObject;
+
+typedef struct {
+	TYPE_HEAD;
+	void (*push)(HeapObject *heap, Object *priority, Object *item);
+	Object *(*pop)(HeapObject *heap);
+
+	/* raw versions for internal use, no result object is created */
+	int_t (*size)(HeapObject *heap);
+} HeapType;
+
+extern HeapType heaptype;
+
+#endif
@@ -0,0 +1,174 @@
+/* jit.c
+ *
+ * Run a program as native code instead of interpreting it.
+ *
+ * The program is translated to C (see compiler.c), the C code is compiled
+ * by the system's C compiler into a shared library, and the library is
+ * loaded into the interpreter. The translated code calls the object
+ * functions of the running interpreter, so the interpreter must be linked
+ * with its symbols exported (gcc -rdynamic).
+ *
+ * The translation is done in a child process. It leaves the state of the
+ * interpreter (modules, identifiers, reader) untouched, and when the
+ * program cannot be translated the child simply fails. Whenever one of the
+ * steps fails jit() returns false and the caller falls back to the
+ * interpreter. On platforms without fork() and dlopen() this is always the
+ * case. This includes a TypeError found while translating, as the
+ * interpreter only reports it if the statement is actually executed.
+ *
+ * The C compiler command is JITCC and the directory with the interpreters
+ * header files is JITINCLUDE, see config.h. Environment variable
+ * EXIN_INCLUDE overrides JITINCLUDE. The compiler is started without a
+ * shell, so the words in JITCC are separated by spaces and cannot be quoted.
+ *
+ * 2020	K.W.E. de Lange
+ */
+#define _POSIX_C_SOURCE 200809L	/* for mkdtemp() */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "compiler.h"
+#include "config.h"
+#include "error.h"
+#include "jit.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <dlfcn.h>
+
+
+/* Translate module filename to C in file csource. Error messages go to
+ * file messages.
+ *
+ * return   exit code of the translation, 0 if successful
+ */
+static int translate(const char *filename, const char *csource, const char *messages)
+{
+	int status;
+	pid_t pid;
+
+	fflush(stdout);
+	fflush(stderr);
+
+	if ((pid = fork()) == -1)
+		return -1;
+
+	if (pid == 0) {  /* child */
+		if (freopen(csource, "w", stdout) == NULL || freopen(messages, "w", stderr) == NULL)
+			_exit(-1);
+		exit(compile(filename, true));
+	}
+
+	if (waitpid(pid, &status, 0) == -1 || !WIFEXITED(status))
+		return -1;
+
+	return WEXITSTATUS(status);
+}
+
+
+/* Compile C source file csource into shared library library. The output
+ * of the compiler is discarded.
+ *
+ * return   exit code of the compiler, 0 if successful
+ */
+static int build(const char *include, const char *csource, const char *library)
+{
+	char cc[] = JITCC;
+	char *argv[sizeof cc / 2 + 5];
+	char option[FILENAME_MAX];
+	int argc = 0, status, fd;
+	pid_t pid;
+
+	if (snprintf(option, sizeof option, "-I%s", include) >= (int)sizeof option)
+		return -1;
+
+	for (char *word = strtok(cc, " "); word; word = strtok(NULL, " "))
+		argv[argc++] = word;
+	argv[argc++] = option;
+	argv[argc++] = "-o";
+	argv[argc++] = (char *)library;
+	argv[argc++] = (char *)csource;
+	argv[argc] = NULL;
+
+	fflush(stdout);
+	fflush(stderr);
+
+	if ((pid = fork()) == -1)
+		return -1;
+
+	if (pid == 0) {  /* child */
+		if ((fd = open("/dev/null", O_WRONLY)) != -1) {
+			dup2(fd, STDOUT_FILENO);
+			dup2(fd, STDERR_FILENO);
+		}
+		execvp(argv[0], argv);
+		_exit(-1);
+	}
+
+	if (waitpid(pid, &status, 0) == -1 || !WIFEXITED(status))
+		return -1;
+
+	return WEXITSTATUS(status);
+}
+
+
+/* API: Translate a program to native code and run it.
+ *
+ * filename     module which contains the main program
+ * result       receives the programs exit code
+ * return       true if the program was run, false if the interpreter
+ *              must run it instead
+ */
+bool jit(const char *filename, int *result)
+{
+	char dir[] = "/tmp/exinXXXXXX";
+	char csource[sizeof dir + 8], library[sizeof dir + 8], messages[sizeof dir + 8];
+	const char *include;
+	int (*jit_main)(void);
+	void *handle = NULL;
+	bool ok = false;
+
+	if ((include = getenv("EXIN_INCLUDE")) == NULL)
+		include = JITINCLUDE;
+
+	if (mkdtemp(dir) == NULL)
+		return false;
+
+	snprintf(csource, sizeof csource, "%s/jit.c", dir);
+	snprintf(library, sizeof library, "%s/jit.so", dir);
+	snprintf(messages, sizeof messages, "%s/jit.err", dir);
+
+	if (translate(filename, csource, messages) == 0 && build(include, csource, library) == 0)
+		if ((handle = dlopen(library, RTLD_NOW)) != NULL)
+			if ((*(void **)&jit_main = dlsym(handle, "jit_main")) != NULL)
+				ok = true;
+
+	remove(csource);
+	remove(library);
+	remove(messages);
+	remove(dir);
+
+	if (ok)
+		*result = jit_main();
+	else
+		debug_printf(~NODEBUG, "\njit   : %s", "falling back to interpreter");
+
+	/* the library is not closed as the objects it created may still be used */
+
+	return ok;
+}
+
+#else  /* no fork() and dlopen() */
+
+bool jit(const char *filename, int *result)
+{
+	return false;
+}
+
+#endif
@@ -0,0 +1,12 @@
+/* jit.h
+ *
+ * 2020	K.W.E. de Lange
+ */
+#ifndef _JIT_
+#define _JIT_
+
+#include <stdbool.h>
+
+extern bool jit(const char *filename, int *result);
+
+#endif
@@ -1,474 +1,641 @@
-/* list.c
- *
- * List object operations
- *
- * See list.h for an explanation of of how lists are structured.
- *
- * 2016 K.W.E. de Lange
- */
-#include <stdlib.h>
-#include <stdbool.h>
-
-#include "object.h"
-#include "error.h"
-
-
-/* Create a new empty list object.
- */
-static ListObject *list_alloc(void)
-{
-	ListObject *list;
-
-	if ((list = calloc(1, sizeof(ListObject))) == NULL)
-		error(OutOfMemoryError);
-
-	list->typeobj = (TypeObject *)&listtype;
-	list->type = LIST_T;
-	list->refcount = 0;
-
-	list->head = NULL;
-	list->tail = NULL;
-
-	return list;
-}
-
-
-/* Free a list object, including all list nodes and referenced objects.
- */
-static void list_free(ListObject *list)
-{
-	Object *obj;
-
-	while ((obj = listtype.remove(list, 0)) != NULL)
-		obj_decref(obj);
-
-	free(list);
-}
-
-
-static void list_print(ListObject *list)
-{
-	printf("[");
-
-	for (ListNode *node = list->head; node; node = node->next) {
-		obj_print(node->obj);
-		if (node->next)
-			printf(",");
-	}
-	printf("]");
-}
-
-
-/* Create a copy of a list.
- *
- * The new list contains new objects (= deep copy).
- */
-static ListObject *list_set(ListObject *dest, ListObject *src)
-{
-	Object *obj;
-
-	if (dest->head != NULL)
-		while ((obj = listtype.remove(dest, 0)) != NULL)
-			obj_decref(obj);
-
-	for (ListNode *node = src->head; node; node = node->next)
-		listtype.append(dest, obj_copy(node->obj));
-
-	return dest;
-}
-
-
-static ListObject *list_vset(ListObject *obj, va_list argp)
-{
-	return list_set(obj, va_arg(argp, ListObject *));
-}
-
-
-/* Create a new empty listnode.
- */
-static ListNode *listnode_alloc(void)
-{
-	ListNode *node;
-
-	if ((node = calloc(1, sizeof(ListNode))) == NULL)
-		error(OutOfMemoryError);
-
-	node->typeobj = (TypeObject *)&listnodetype;
-	node->type = LISTNODE_T;
-	node->refcount = 0;
-
-	node->next = NULL;
-	node->prev = NULL;
-	node->obj = NULL;
-
-	return node;
-}
-
-
-/* Free a listnode, and release the object it references.
- */
-static void listnode_free(ListNode *node)
-{
-	if (node->obj)
-		obj_decref(node->obj);
-
-	free(node);
-}
-
-
-static void listnode_print(ListNode *node)
-{
-	obj_print(node->obj);
-}
-
-
-static ListNode *listnode_set(ListNode *node, Object *obj)
-{
-	if (node->obj)
-		obj_decref(node->obj);
-
-	node->obj = obj;
-
-	return node;
-}
-
-
-static ListNode *listnode_vset(ListNode *node, va_list argp)
-{
-	return listnode_set(node, va_arg(argp, Object *));
-}
-
-
-/* Count the number of listnodes in a list.
- */
-static int_t length(ListObject *list)
-{
-	ListNode *node;
-	int_t i;
-
-	for (i = 0, node = list->head; node; i++, node = node->next)
-		;
-
-	return i;
-}
-
-
-static Object *list_length(ListObject *list)
-{
-	return obj_create(INT_T, length(list));
-}
-
-
-/* Create a new list which contains the objects from op1 and op2.
- */
-static Object *list_concat(ListObject *op1, ListObject *op2)
-{
-	ListObject *list;
-	ListNode *item;
-	int_t i;
-
-	list = (ListObject *)obj_alloc(LIST_T);
-
-	for (i = 0; i < length(op1); i++) {
-		item = listtype.item(op1, i);
-		listtype.append(list, obj_copy(item->obj));
-		obj_decref(item);
-	}
-	for (i = 0; i < length(op2); i++) {
-		item = listtype.item(op2, i);
-		listtype.append(list, obj_copy(item->obj));
-		obj_decref(item);
-	}
-	return (Object *)list;
-}
-
-
-/* Create a new list which contains n times an existing list.
- */
-static Object *list_repeat(Object *op1, Object *op2)
-{
-	ListObject *list;
-	ListNode *item;
-	int_t times;
-
-	Object *s = TYPE(op1) == LIST_T ? op1 : op2;
-	Object *n = TYPE(op1) == LIST_T ? op2 : op1;
-
-	times = obj_as_int(n);
-
-	list = (ListObject *)obj_alloc(LIST_T);
-
-	while (times--)
-		for (int_t i = 0; i < length((ListObject *)s); i++) {
-			item = listtype.item((ListObject *)s, i);
-			listtype.append(list, obj_copy(item->obj));
-			obj_decref(item);
-		}
-
-	return (Object *)list;
-}
-
-
-/* Compare the content of two lists by index (math: tuple).
- */
-static bool list_cmp(ListObject *op1, ListObject *op2)
-{
-	bool equal;
-	Object *obj;
-	int_t i, l1;
-	ListNode *item1, *item2;
-
-	l1 = length(op1);
-
-	if (l1 != length(op2))
-		return false;  /* the lists should at least be of equal length */
-
-	for (equal = true, i = 0; i < l1; i++) {
-		item1 = listtype.item(op1, i);
-		item2 = listtype.item(op2, i);
-		obj = obj_eql((Object *)item1, (Object *)item2);
-		equal = obj_as_bool(obj);
-		obj_decref(item1);
-		obj_decref(item2);
-		obj_decref(obj);
-		if (equal == false)
-			break;  /* stop compare on first mismatch */
-	}
-	return i == l1 ? true : false;  /* true (1) = equal, false (0) = not equal */
-}
-
-
-static Object *list_eql(ListObject *op1, ListObject *op2)
-{
-	int result = list_cmp(op1, op2);
-
-	return obj_create(INT_T, (int_t)result);
-}
-
-
-static Object *list_neq(ListObject *op1, ListObject *op2)
-{
-	int result = list_cmp(op1, op2);
-
-	return obj_create(INT_T, (int_t)!result);
-}
-
-
-/* Retrieve a listnode from a list by index.
- * Beware: The refcount of the listnode is increased by 1.
- */
-static ListNode *list_item(ListObject *list, int index)
-{
-	ListNode *node;
-	int_t len, i;
-
-	len = length(list);
-
-	if (index < 0)
-		index += len;
-
-	if (index < 0 || index >= len)
-		return NULL;  /* IndexError: index out of range */
-
-	for (i = 0, node = list->head; node; i++, node = node->next) {
-		if (i == index) {
-			break;
-		}
-	}
-
-	obj_incref(node);
-
-	return node;
-}
-
-
-/* Create a new list from a slice of an existing list.
- *
- * The new list contains new object (= deep copy). Start and end are
- * automatically adjusted to the nearest possible values.
- */
-static ListObject *list_slice(ListObject *list, int start, int end)
-{
-	ListObject *slice;
-	ListNode *node;
-	int_t len;
-
-	len = length(list);
-
-	if (start < 0)
-		start += len;
-
-	if (end < 0)
-		end += len;
-
-	if (start < 0)
-		start = 0;
-
-	if (end >= len)
-		end = len;
-
-	slice = (ListObject *)obj_alloc(LIST_T);
-
-	for (int_t i = start; i < end; i++) {
-		node = listtype.item(list, i);
-		listtype.append(slice, obj_copy(node->obj));
-		obj_decref(node);
-	}
-
-	return slice;
-}
-
-
-/* Append an object to the end of a list.
- *
- * list     list to append object to
- * obj      object to append
- */
-static void list_append_object(ListObject *list, Object *obj)
-{
-	ListNode *node, *tail;
-
-	node = (ListNode *)obj_create(LISTNODE_T, obj);
-
-	if (list->head == NULL) {  /* append to empty list */
-		list->head = node;
-		list->tail = node;
-	} else {  /* append to list which already has one of more listnodes */
-		tail = list->tail;
-		node->prev = tail;
-		tail->next = node;
-		list->tail = node;
-	}
-}
-
-
-/* Insert an object before the listnode with number index.
- *
- * Index is automatically adjusted to the nearest possible value.
- * A negative index counts back from the end of the list. Index -1
- * points to the last listnode.
- *
- * list     list to insert object into
- * index    insert object before this index
- * obj      object to insert
- */
-static void list_insert_object(ListObject *list, int index, Object *obj)
-{
-	ListNode *node, *iptr;
-	int_t len;
-
-	node = (ListNode *)obj_create(LISTNODE_T, obj);
-
-	if (list->head == NULL) {  /* insert in empty list */
-		list->head = node;
-		list->tail = node;
-	} else {  /* insert in list which already has one or more listnodes */
-		len = length(list);
-
-		if (index < 0)
-			index += len;
-
-		if (index <= 0) {  /* insert before first listnode */
-			node->next = list->head;
-			node->next->prev = node;
-			node->prev = NULL;
-			list->head = node;
-		} else if (index >= len) {  /* insert after last listnode */
-			iptr = list->tail;
-			node->prev = iptr;
-			iptr->next = node;
-			list->tail = node;
-		} else {  /* insert somewhere in the middle */
-			for (iptr = list->head; index--; iptr = iptr->next)
-				;
-			/* insert before iptr */
-			node->next = iptr;
-			node->prev = iptr->prev;
-			node->next->prev = node;
-			node->prev->next = node;
-		}
-	}
-}
-
-
-/* Remove a listnode from a list.
- *
- * Index must exist (numbering starts at 0). A negative index counts back
- * from the end of the list. Index -1 points to the last listnode.
- *
- * list     list to remove object from
- * index    index of object to remove
- * return   object which was removed from list
- */
-static Object *list_remove_object(ListObject *list, int index)
-{
-	ListNode *node;
-	Object *obj = NULL;
-	int_t len, i;
-
-	len = length(list);
-
-	if (index < 0)
-		index += len;  /* negative index */
-
-	if (index < 0 || index >= len)
-		return NULL;  /* IndexError: index out of range */
-
-	for (i = 0, node = list->head; node; i++, node = node->next) {
-		if (i == index) {
-			obj = node->obj;
-			if (list->head == list->tail) {  /* list contains only 1 node */
-				list->head = NULL;
-				list->tail = NULL;
-			} else if (node->prev == NULL) {  /* at least 2 nodes, remove first */
-				list->head = node->next;
-				node->next->prev = NULL;
-			} else if (node->next == NULL) {  /* at least 2 nodes, remove last */
-				list->tail = node->prev;
-				node->prev->next = NULL;
-			} else {  /* at least 3 nodes, node is not first or last */
-				node->prev->next = node->next;
-				node->next->prev = node->prev;
-			}
-			obj_incref(obj);  /* avoid that obj (= return value) is released */
-			obj_decref(node);
-			break;
-		}
-	}
-	return obj;
-}
-
-
-/* List object API.
-*/
-ListType listtype = {
-	.name = "list",
-	.alloc = (Object *(*)())list_alloc,
-	.free = (void (*)(Object *))list_free,
-	.print = (void (*)(Object *))list_print,
-	.set = (Object *(*)())list_set,
-	.vset = (Object *(*)(Object *, va_list))list_vset,
-
-	.length = list_length,
-	.item = list_item,
-	.slice = list_slice,
-	.concat = list_concat,
-	.repeat = list_repeat,
-	.eql = list_eql,
-	.neq = list_neq,
-	.insert = list_insert_object,
-	.append = list_append_object,
-	.remove = list_remove_object
-	};
-
-
-/* Listnode object API.
- */
-ListNodeType listnodetype = {
-	.name = "listnode",
-	.alloc = (Object *(*)())listnode_alloc,
-	.free = (void (*)(Object *))listnode_free,
-	.print = (void (*)(Object *))listnode_print,
-	.set = (Object *(*)())listnode_set,
-	.vset = (Object *(*)(Object *, va_list))listnode_vset
-	};
+/* list.c
+ *
+ * List object operations
+ *
+ * See list.h for an explanation of of how lists are structured.
+ *
+ * 2016 K.W.E. de Lange
+ */
+#include <limits.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "number.h"
+#include "object.h"
+#include "error.h"
+
+
+/* Item a reference to a list item refers to, see reference() */
+typedef struct {
+	ListObject *list;	/* list which contains the item */
+	int index;			/* position of the item in the list */
+} Target;
+
+#define target(node)	((Target *)(node)->next)
+
+static ListNode *node_at(ListObject *list, int index);
+
+
+/* Create a new empty list object.
+ */
+static ListObject *list_alloc(void)
+{
+	ListObject *list;
+
+	if ((list = calloc(1, sizeof(ListObject))) == NULL)
+		error(OutOfMemoryError);
+
+	list->type = LIST_T;
+	list->refcount = 0;
+
+	list->head = NULL;
+	list->tail = NULL;
+	list->shared = NULL;
+
+	return list;
+}
+
+
+/* Remove all nodes from a list. Shared nodes are left to their owner.
+ */
+static void list_clear(ListObject *list)
+{
+	ListNode *node, *next;
+
+	if (list->shared)
+		obj_decref(list->shared);
+	else
+		for (node = list->head; node; node = next) {
+			next = node->next;
+			obj_decref(node);
+		}
+
+	list->head = NULL;
+	list->tail = NULL;
+	list->shared = NULL;
+}
+
+
+/* Free a list object, including all list nodes and referenced objects.
+ */
+static void list_free(ListObject *list)
+{
+	list_clear(list);
+	free(list);
+}
+
+
+static void list_print(ListObject *list)
+{
+	printf("[");
+
+	for (ListNode *node = list->head; node; node = list_next(list, node)) {
+		obj_print(node->obj);
+		if (node != list->tail)
+			printf(",");
+	}
+	printf("]");
+}
+
+
+/* Give a list which shares its nodes a copy of its own (copy-on-write).
+ *
+ * The copy contains new objects (= deep copy), as a slice did before it
+ * started sharing nodes.
+ */
+static void own(ListObject *list)
+{
+	ListObject *shared = list->shared;
+	ListNode *node = list->head, *tail = list->tail;
+
+	if (shared == NULL)
+		return;
+
+	list->head = NULL;
+	list->tail = NULL;
+	list->shared = NULL;
+
+	for (; node; node = node == tail ? NULL : node->next)
+		listtype.append(list, obj_copy(node->obj));
+
+	obj_decref(shared);
+}
+
+
+/* Create a copy of a list.
+ *
+ * The new list contains new objects (= deep copy).
+ */
+static ListObject *list_set(ListObject *dest, ListObject *src)
+{
+	if (dest == src)
+		return dest;
+
+	list_clear(dest);
+
+	for (ListNode *node = src->head; node; node = list_next(src, node))
+		listtype.append(dest, obj_copy(node->obj));
+
+	return dest;
+}
+
+
+static ListObject *list_vset(ListObject *obj, va_list argp)
+{
+	return list_set(obj, va_arg(argp, ListObject *));
+}
+
+
+/* Create a new empty listnode.
+ */
+static ListNode *listnode_alloc(void)
+{
+	ListNode *node;
+
+	if ((node = calloc(1, sizeof(ListNode))) == NULL)
+		error(OutOfMemoryError);
+
+	node->type = LISTNODE_T;
+	node->refcount = 0;
+
+	node->next = NULL;
+	node->obj = NULL;
+
+	return node;
+}
+
+
+/* Free a listnode, and release the object it references.
+ */
+static void listnode_free(ListNode *node)
+{
+	if (node->flags & OBJ_VIEW) {
+		obj_decref((Object *)target(node)->list);
+		free(target(node));
+	}
+
+	if (node->obj)
+		obj_decref(node->obj);
+
+	free(node);
+}
+
+
+static void listnode_print(ListNode *node)
+{
+	obj_print(node->obj);
+}
+
+
+/* Assign obj to a listnode. For a reference obj is stored in the item at
+ * its position in the list, also if the list received its own nodes since
+ * the reference was made. If the list became too short it is not stored.
+ */
+static ListNode *listnode_set(ListNode *node, Object *obj)
+{
+	ListObject *list;
+	ListNode *item;
+
+	if (node->flags & OBJ_VIEW) {  /* reference, store obj in the list */
+		list = target(node)->list;
+		own(list);
+		if ((item = node_at(list, target(node)->index)) != NULL) {
+			listnode_set(item, obj);
+			obj = item->obj;
+			obj_incref(obj);
+		}
+	}
+
+	if (node->obj)
+		obj_decref(node->obj);
+
+	node->obj = obj_promote(obj);
+
+	return node;
+}
+
+
+static ListNode *listnode_vset(ListNode *node, va_list argp)
+{
+	return listnode_set(node, va_arg(argp, Object *));
+}
+
+
+/* Count the number of listnodes in a list.
+ */
+static int_t length(ListObject *list)
+{
+	ListNode *node;
+	int_t i;
+
+	for (i = 0, node = list->head; node; i++, node = list_next(list, node))
+		;
+
+	return i;
+}
+
+
+static Object *list_length(ListObject *list)
+{
+	return inttype.shared(length(list));
+}
+
+
+/* Create a new list which contains the objects from op1 and op2.
+ */
+static Object *list_concat(ListObject *op1, ListObject *op2)
+{
+	ListObject *list;
+	ListNode *node;
+
+	list = (ListObject *)obj_alloc(LIST_T);
+
+	for (node = op1->head; node; node = list_next(op1, node))
+		listtype.append(list, obj_copy(node->obj));
+	for (node = op2->head; node; node = list_next(op2, node))
+		listtype.append(list, obj_copy(node->obj));
+
+	return (Object *)list;
+}
+
+
+/* Create a new list which contains n times an existing list.
+ */
+static Object *list_repeat(Object *op1, Object *op2)
+{
+	ListObject *list;
+	ListNode *node;
+	int_t times;
+
+	ListObject *s = (ListObject *)(TYPE(op1) == LIST_T ? op1 : op2);
+	Object *n = TYPE(op1) == LIST_T ? op2 : op1;
+
+	times = obj_as_int(n);
+
+	list = (ListObject *)obj_alloc(LIST_T);
+
+	while (times-- > 0)
+		for (node = s->head; node; node = list_next(s, node))
+			listtype.append(list, obj_copy(node->obj));
+
+	return (Object *)list;
+}
+
+
+/* Compare the content of two lists by index (math: tuple).
+ */
+static bool list_equal(ListObject *op1, ListObject *op2)
+{
+	ListNode *item1, *item2;
+
+	for (item1 = op1->head, item2 = op2->head; item1 && item2; \
+		 item1 = list_next(op1, item1), item2 = list_next(op2, item2))
+		if (obj_equal(item1->obj, item2->obj) == false)
+			return false;  /* stop compare on first mismatch */
+
+	return item1 == NULL && item2 == NULL;  /* lists must be of equal length */
+}
+
+
+static Object *list_eql(ListObject *op1, ListObject *op2)
+{
+	int result = list_equal(op1, op2);
+
+	return inttype.shared((int_t)result);
+}
+
+
+static Object *list_neq(ListObject *op1, ListObject *op2)
+{
+	int result = list_equal(op1, op2);
+
+	return inttype.shared((int_t)!result);
+}
+
+
+/* Return the listnode with number index, or NULL if there is none.
+ */
+static ListNode *node_at(ListObject *list, int index)
+{
+	ListNode *node;
+
+	if (index < 0)
+		index += (int)length(list);
+
+	if (index < 0)
+		return NULL;
+
+	for (node = list->head; node && index; index--)
+		node = list_next(list, node);
+
+	return node;
+}
+
+
+/* Return a reference to item index of a list which shares its nodes. This
+ * is a listnode with flag OBJ_VIEW set which is not linked into a list, but
+ * points to the list and the position of the item via member next (see
+ * macro target()). Assigning to the reference stores the value in the list,
+ * see listnode_set(). The position is kept instead of the node, as the
+ * nodes are replaced when the list receives its own copy of them.
+ */
+static ListNode *reference(ListObject *list, ListNode *node, int index)
+{
+	ListNode *ref = (ListNode *)obj_alloc(LISTNODE_T);
+	Target *t;
+
+	if ((t = malloc(sizeof(Target))) == NULL)
+		error(OutOfMemoryError);
+
+	t->list = list;
+	t->index = index;
+	obj_incref(list);
+
+	ref->flags |= OBJ_VIEW;
+	ref->next = (ListNode *)t;
+	ref->obj = node->obj;
+	obj_incref(ref->obj);
+
+	return ref;
+}
+
+
+/* Retrieve a listnode from a list by index.
+ * Beware: The refcount of the listnode is increased by 1.
+ *
+ * Items of a list which shares its nodes are returned as a reference. An
+ * item which can be changed without assigning to it (like a list) cannot
+ * be shared, so then the list first receives its own nodes.
+ */
+static ListNode *list_item(ListObject *list, int index)
+{
+	ListNode *node;
+
+	if ((node = node_at(list, index)) == NULL)
+		return NULL;  /* IndexError: index out of range */
+
+	if (list->shared) {
+		if (!isList(node->obj) && !isHeap(node->obj) && !isDeque(node->obj) && !isMatrix(node->obj))
+			return reference(list, node, index < 0 ? index + (int)length(list) : index);
+		own(list);
+		node = node_at(list, index);
+	}
+
+	obj_incref(node);
+
+	return node;
+}
+
+
+/* Create a new list from a slice of an existing list.
+ *
+ * The new list uses the listnodes of the existing list, which are moved
+ * to a hidden list which owns them (see list.h). So no objects are copied,
+ * only the start and the end of the slice are searched. Start and end are
+ * automatically adjusted to the nearest possible values.
+ */
+static ListObject *list_slice(ListObject *list, int start, int end)
+{
+	ListObject *slice, *shared;
+	ListNode *first, *last;
+	int_t len;
+
+	if (start < 0 || end < 0) {
+		len = length(list);
+		if (start < 0)
+			start += len;
+		if (end < 0)
+			end += len;
+	}
+
+	if (start < 0)
+		start = 0;
+
+	slice = (ListObject *)obj_alloc(LIST_T);
+
+	if (start >= end || (first = node_at(list, start)) == NULL)
+		return slice;  /* empty slice */
+
+	if (end == INT_MAX)  /* no end specified */
+		last = list->tail;
+	else
+		for (last = first; --end > start && last != list->tail; )
+			last = last->next;
+
+	if ((shared = list->shared) == NULL) {
+		shared = (ListObject *)obj_alloc(LIST_T);
+		shared->head = list->head;
+		shared->tail = list->tail;
+		list->shared = shared;
+	}
+	obj_incref(shared);
+
+	slice->head = first;
+	slice->tail = last;
+	slice->shared = shared;
+
+	return slice;
+}
+
+
+/* Append an object to the end of a list.
+ *
+ * list     list to append object to
+ * obj      object to append
+ */
+static void list_append_object(ListObject *list, Object *obj)
+{
+	ListNode *node, *tail;
+
+	own(list);
+
+	node = listnode_set((ListNode *)obj_alloc(LISTNODE_T), obj);
+
+	if (list->head == NULL) {  /* append to empty list */
+		list->head = node;
+		list->tail = node;
+	} else {  /* append to list which already has one of more listnodes */
+		tail = list->tail;
+		tail->next = node;
+		list->tail = node;
+	}
+}
+
+
+/* Insert an object before the listnode with number index.
+ *
+ * Index is automatically adjusted to the nearest possible value.
+ * A negative index counts back from the end of the list. Index -1
+ * points to the last listnode.
+ *
+ * list     list to insert object into
+ * index    insert object before this index
+ * obj      object to insert
+ */
+static void list_insert_object(ListObject *list, int index, Object *obj)
+{
+	ListNode *node, *iptr;
+	int_t len;
+
+	own(list);
+
+	node = listnode_set((ListNode *)obj_alloc(LISTNODE_T), obj);
+
+	if (list->head == NULL) {  /* insert in empty list */
+		list->head = node;
+		list->tail = node;
+	} else {  /* insert in list which already has one or more listnodes */
+		len = length(list);
+
+		if (index < 0)
+			index += len;
+
+		if (index <= 0) {  /* insert before first listnode */
+			node->next = list->head;
+			list->head = node;
+		} else if (index >= len) {  /* insert after last listnode */
+			iptr = list->tail;
+			iptr->next = node;
+			list->tail = node;
+		} else {  /* insert somewhere in the middle */
+			for (iptr = list->head; --index; iptr = iptr->next)
+				;
+			/* insert after iptr */
+			node->next = iptr->next;
+			iptr->next = node;
+		}
+	}
+}
+
+
+/* Remove a listnode from a list.
+ *
+ * Index must exist (numbering starts at 0). A negative index counts back
+ * from the end of the list. Index -1 points to the last listnode.
+ *
+ * list     list to remove object from
+ * index    index of object to remove
+ * return   object which was removed from list
+ */
+static Object *list_remove_object(ListObject *list, int index)
+{
+	ListNode *node, *prev = NULL;
+	Object *obj = NULL;
+	int_t i;
+
+	own(list);
+
+	if (index < 0)
+		index += (int)length(list);  /* negative index */
+
+	if (index < 0)
+		return NULL;  /* IndexError: index out of range */
+
+	for (i = 0, node = list->head; node; i++, prev = node, node = node->next) {
+		if (i == index) {
+			obj = node->obj;
+			if (list->head == list->tail) {  /* list contains only 1 node */
+				list->head = NULL;
+				list->tail = NULL;
+			} else if (prev == NULL) {  /* at least 2 nodes, remove first */
+				list->head = node->next;
+			} else if (node->next == NULL) {  /* at least 2 nodes, remove last */
+				list->tail = prev;
+				prev->next = NULL;
+			} else {  /* at least 3 nodes, node is not first or last */
+				prev->next = node->next;
+			}
+			obj_incref(obj);  /* avoid that obj (= return value) is released */
+			obj_decref(node);
+			break;
+		}
+	}
+	return obj;
+}
+
+
+/* Method: list.insert(index, object)
+ */
+static Object *method_insert(Object *list, Object **argv)
+{
+	int_t index = obj_as_int(argv[0]);
+
+	obj_decref(argv[0]);
+	list_insert_object((ListObject *)list, (int)index, obj_take(argv[1]));
+
+	return obj_alloc(NONE_T);
+}
+
+
+/* Method: list.append(object)
+ */
+static Object *method_append(Object *list, Object **argv)
+{
+	list_append_object((ListObject *)list, obj_take(argv[0]));
+
+	return obj_alloc(NONE_T);
+}
+
+
+/* Method: list.remove(index)
+ */
+static Object *method_remove(Object *list, Object **argv)
+{
+	int_t index = obj_as_int(argv[0]);
+	Object *obj;
+
+	obj_decref(argv[0]);
+
+	if ((obj = list_remove_object((ListObject *)list, (int)index)) == NULL)
+		error(IndexError);
+
+	return obj;
+}
+
+
+/* Method: list.len
+ */
+static Object *method_len(Object *list, Object **argv)
+{
+	return list_length((ListObject *)list);
+}
+
+
+static Method listmethod[] = {
+	{"append", method_append, 1},
+	{"insert", method_insert, 2},
+	{"len", method_len, NOARGLIST},
+	{"remove", method_remove, 1},
+	{NULL}
+};
+
+static MethodTable listmethods = { .method = listmethod };
+
+
+/* List object API.
+*/
+ListType listtype = {
+	.name = "list",
+	.alloc = (Object *(*)())list_alloc,
+	.free = (void (*)(Object *))list_free,
+	.print = (void (*)(Object *))list_print,
+	.set = (Object *(*)())list_set,
+	.vset = (Object *(*)(Object *, va_list))list_vset,
+	.methods = &listmethods,
+
+	.length = list_length,
+	.item = list_item,
+	.slice = list_slice,
+	.concat = list_concat,
+	.repeat = list_repeat,
+	.eql = list_eql,
+	.neq = list_neq,
+	.insert = list_insert_object,
+	.append = list_append_object,
+	.remove = list_remove_object,
+
+	.size = length,
+	.equal = list_equal
+	};
+
+
+/* Listnode object API.
+ */
+ListNodeType listnodetype = {
+	.name = "listnode",
+	.alloc = (Object *(*)())listnode_alloc,
+	.free = (void (*)(Object *))listnode_free,
+	.print = (void (*)(Object *))listnode_print,
+	.set = (Object *(*)())listnode_set,
+	.vset = (Object *(*)(Object *, va_list))listnode_vset
+	};
@@ -1,50 +1,68 @@
-/* list.h
- *
- * A list contains 0 of more listnodes. The list object is a header which
- * points to the first listnode. The last listnode points to the header.
- * Every listnode points to the object which is stored in the list. In
- * this way the list structure is agnostic of the object type stored.
- *
- * 2016	K.W.E. de Lange
- */
-#ifndef _LIST_
-#define _LIST_
-
-#include "object.h"
-
-typedef struct listobject {
-	OBJ_HEAD;
-	struct listnode *head;	/* first node in the list, NULL for empty list */
-	struct listnode *tail;	/* last node in the list, NULL for empty list */
-} ListObject;
-
-typedef struct listnode {
-	OBJ_HEAD;
-	struct listnode *next;	/* next node in the list, NULL for last */
-	struct listnode *prev;	/* previous node in the list, NULL for first */
-	struct object *obj;  	/* object which is stored in the list */
-} ListNode;
-
-typedef struct {
-	TYPE_HEAD;
-	Object *(*length)(ListObject *obj);
-	ListNode *(*item)(ListObject *str, int index);
-	ListObject *(*slice)(ListObject *obj, int start, int end);
-	Object *(*concat)(ListObject *op1, ListObject *op2);
-	Object *(*repeat)(Object *op1, Object *op2);
-	Object *(*eql)(ListObject *op1, ListObject *op2);
-	Object *(*neq)(ListObject *op1, ListObject *op2);
-	void (*insert)(ListObject *list, int index, Object *obj);
-	void (*append)(ListObject *list, Object *obj);
-	Object *(*remove)(ListObject *list, int index);
-} ListType;
-
-extern ListType listtype;
-
-typedef struct {
-	TYPE_HEAD;
-} ListNodeType;
-
-extern ListNodeType listnodetype;
-
-#endif
+/* list.h
+ *
+ * A list contains 0 of more listnodes. The list object is a header which
+ * points to the first and the last listnode. Listnodes are singly linked
+ * to keep them small. Every listnode points to the object which is stored
+ * in the list. In this way the list structure is agnostic of the object
+ * type stored.
+ *
+ * A slice of a list does not copy the listnodes but uses the nodes of the
+ * list it was taken from (see list_slice()). The nodes are then owned by a
+ * hidden list which is referred to by member 'shared' of every list using
+ * them. Such a list only walks from head up to and including tail, see
+ * macro list_next(). Before a list which shares its nodes is changed it
+ * receives its own copy of them (copy-on-write, see own() in list.c).
+ *
+ * 2016	K.W.E. de Lange
+ */
+#ifndef _LIST_
+#define _LIST_
+
+#include "object.h"
+
+typedef struct listobject {
+	OBJ_HEAD;
+	struct listnode *head;	/* first node in the list, NULL for empty list */
+	struct listnode *tail;	/* last node in the list, NULL for empty list */
+	struct listobject *shared;	/* owner of the nodes if shared with other lists, else NULL */
+} ListObject;
+
+typedef struct listnode {
+	OBJ_HEAD;
+	struct listnode *next;	/* next node in the list, NULL for last */
+	struct object *obj;  	/* object which is stored in the list */
+} ListNode;
+
+/* node after 'node' in 'list', NULL for the last */
+#define list_next(list, node)	((node) == (list)->tail ? NULL : (node)->next)
+
+/* list shares its nodes with other lists */
+#define list_sharing(list)	(((ListObject *)(list))->shared != NULL)
+
+typedef struct {
+	TYPE_HEAD;
+	Object *(*length)(ListObject *obj);
+	ListNode *(*item)(ListObject *str, int index);
+	ListObject *(*slice)(ListObject *obj, int start, int end);
+	Object *(*concat)(ListObject *op1, ListObject *op2);
+	Object *(*repeat)(Object *op1, Object *op2);
+	Object *(*eql)(ListObject *op1, ListObject *op2);
+	Object *(*neq)(ListObject *op1, ListObject *op2);
+	void (*insert)(ListObject *list, int index, Object *obj);
+	void (*append)(ListObject *list, Object *obj);
+	Object *(*remove)(ListObject *list, int index);
+
+	/* raw versions for internal use, no result object is created */
+	int_t (*size)(ListObject *obj);
+	bool (*equal)(ListObject *op1, ListObject *op2);
+} ListType;
+
+extern ListType listtype;
+
+typedef struct {
+	TYPE_HEAD;
+} ListNodeType;
+
+extern ListNodeType listnodetype;
+
+#endif
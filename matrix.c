@@ -0,0 +1,605 @@
+/* matrix.c
+ *
+ * Matrix object operations
+ *
+ * See matrix.h for an explanation of how matrices are structured. Matrix
+ * multiplication (method dot()) works on blocks of the operands which fit
+ * in the processor cache, see multiply() and benchmark/matrix.x.
+ *
+ * 2020	K.W.E. de Lange
+ */
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "number.h"
+#include "object.h"
+#include "error.h"
+#include "matrix.h"
+
+/* Block sizes for multiply(). A block of KBLOCK rows and JBLOCK columns of
+ * the right operand (256 kB) is reused for all rows of the left operand.
+ */
+#define KBLOCK	128
+#define JBLOCK	256
+
+/* Block size for transpose() */
+#define TBLOCK	32
+
+
+/* Create a new empty matrix object.
+ */
+static MatrixObject *matrix_alloc(void)
+{
+	MatrixObject *m;
+
+	if ((m = calloc(1, sizeof(MatrixObject))) == NULL)
+		error(OutOfMemoryError);
+
+	m->type = MATRIX_T;
+	m->refcount = 0;
+
+	m->rows = 0;
+	m->cols = 0;
+	m->data = NULL;
+	m->base = NULL;
+	m->row = 0;
+
+	return m;
+}
+
+
+/* Free a matrix object. A row view releases its matrix.
+ */
+static void matrix_free(MatrixObject *m)
+{
+	if (m->base)
+		obj_decref(m->base);
+	else
+		free(m->data);
+
+	free(m);
+}
+
+
+/* Give a matrix new data with all elements 0.
+ */
+static void allocate(MatrixObject *m, size_t rows, size_t cols)
+{
+	float_t *data = NULL;
+
+	if (cols && rows > SIZE_MAX / sizeof(float_t) / cols)
+		error(OutOfMemoryError);
+
+	if (rows && cols && (data = calloc(rows * cols, sizeof(float_t))) == NULL)
+		error(OutOfMemoryError);
+
+	free(m->data);
+
+	m->data = data;
+	m->rows = rows;
+	m->cols = cols;
+}
+
+
+/* Create a new matrix with all elements 0.
+ */
+static MatrixObject *matrix_create(size_t rows, size_t cols)
+{
+	MatrixObject *m = (MatrixObject *)obj_alloc(MATRIX_T);
+
+	allocate(m, rows, cols);
+
+	return m;
+}
+
+
+/* Return the elements of a matrix and its number of rows and columns.
+ *
+ * For a row view these are read from the matrix it was taken from, as
+ * that matrix may have been given a different size since.
+ */
+static float_t *elements(MatrixObject *m, size_t *rows, size_t *cols)
+{
+	MatrixObject *base = m->base;
+
+	if (base == NULL) {
+		*rows = m->rows;
+		*cols = m->cols;
+		return m->data;
+	}
+	if (m->row >= base->rows)
+		error(IndexError);
+
+	*rows = 1;
+	*cols = base->cols;
+	return base->data + m->row * base->cols;
+}
+
+
+static void matrix_print(MatrixObject *m)
+{
+	size_t rows, cols;
+	float_t *e = elements(m, &rows, &cols);
+
+	if (m->base == NULL)
+		printf("[");
+
+	for (size_t i = 0; i < rows; i++) {
+		printf("[");
+		for (size_t j = 0; j < cols; j++)
+			printf(j ? ",%.*G" : "%.*G", 15, e[i * cols + j]);
+		printf(i + 1 < rows ? "]," : "]");
+	}
+
+	if (m->base == NULL)
+		printf("]");
+}
+
+
+/* Read the elements of a list into a new array.
+ *
+ * A list of lists gives one row per list, a list of numbers a single row.
+ * The caller must free the array.
+ */
+static float_t *from_list(ListObject *list, size_t *rows, size_t *cols)
+{
+	ListObject *row;
+	float_t *data, *e;
+	ListNode *node, *n;
+	size_t len;
+
+	*rows = *cols = 0;
+
+	if (list->head && isList(list->head->obj)) {
+		*rows = (size_t)listtype.size(list);
+		*cols = (size_t)listtype.size((ListObject *)list->head->obj);
+	} else if (list->head) {
+		*rows = 1;
+		*cols = (size_t)listtype.size(list);
+	}
+
+	if ((data = calloc(*rows * *cols + 1, sizeof(float_t))) == NULL)
+		error(OutOfMemoryError);
+
+	e = data;
+
+	if (list->head && isList(list->head->obj))
+		for (node = list->head; node; node = list_next(list, node)) {
+			if (!isList(node->obj))
+				error(ValueError, "matrix row must be a list, not %s", TYPENAME(node->obj));
+			for (row = (ListObject *)node->obj, n = row->head, len = 0; n; n = list_next(row, n), len++)
+				if (len < *cols)
+					*e++ = obj_as_float(n->obj);
+			if (len != *cols)
+				error(ValueError, "matrix rows must have equal length");
+		}
+	else
+		for (node = list->head; node; node = list_next(list, node))
+			*e++ = obj_as_float(node->obj);
+
+	return data;
+}
+
+
+/* Fill a matrix with the elements of another matrix or a list.
+ *
+ * A matrix receives the shape of src. A row view keeps its shape, and
+ * src must contain exactly as many elements as the row. As src can be a
+ * row view of dest the old data of dest is freed after copying.
+ */
+static MatrixObject *matrix_set(MatrixObject *dest, Object *src)
+{
+	size_t rows, cols, r, c;
+	float_t *data, *e, *old = NULL;
+
+	if ((Object *)dest == src)
+		return dest;
+
+	if (isMatrix(src))
+		data = elements((MatrixObject *)src, &rows, &cols);
+	else
+		data = from_list(obj_as_list(src), &rows, &cols);
+
+	if (dest->base) {
+		e = elements(dest, &r, &c);
+		if (rows * cols != c)
+			error(ValueError, "cannot assign %lu elements to a row of %lu", \
+							  (unsigned long)(rows * cols), (unsigned long)c);
+	} else {
+		old = dest->data;
+		dest->data = NULL;
+		allocate(dest, rows, cols);
+		e = dest->data;
+	}
+	if (rows && cols)
+		memmove(e, data, rows * cols * sizeof(float_t));
+
+	free(old);
+
+	if (!isMatrix(src))
+		free(data);
+
+	return dest;
+}
+
+
+static MatrixObject *matrix_vset(MatrixObject *m, va_list argp)
+{
+	return matrix_set(m, va_arg(argp, Object *));
+}
+
+
+/* Retrieve a row from a matrix, or an element from a row view, by index.
+ * A negative index counts back from the end.
+ *
+ * return   new row view or float object, NULL if index is out of range
+ */
+static Object *matrix_item(MatrixObject *m, int index)
+{
+	MatrixObject *view;
+	size_t rows, cols;
+	float_t *e = elements(m, &rows, &cols);
+	size_t len = m->base ? cols : rows;
+
+	if (index < 0)
+		index += (int)len;
+
+	if (index < 0 || (size_t)index >= len)
+		return NULL;  /* IndexError: index out of range */
+
+	if (m->base)
+		return obj_new_float(e[index]);
+
+	view = (MatrixObject *)obj_alloc(MATRIX_T);
+	view->flags |= OBJ_VIEW;
+	view->rows = 1;
+	view->cols = cols;
+	view->base = m;
+	view->row = (size_t)index;
+	obj_incref(m);
+
+	return (Object *)view;
+}
+
+
+/* Set element number index of a row view.
+ *
+ * return   false if index is out of range
+ */
+static bool matrix_store(MatrixObject *row, int index, float_t value)
+{
+	size_t rows, cols;
+	float_t *e = elements(row, &rows, &cols);
+
+	if (index < 0)
+		index += (int)cols;
+
+	if (index < 0 || (size_t)index >= cols)
+		return false;
+
+	e[index] = value;
+
+	return true;
+}
+
+
+/* Number of rows of a matrix, or number of elements of a row view.
+ */
+static int_t size(MatrixObject *m)
+{
+	size_t rows, cols;
+
+	elements(m, &rows, &cols);
+
+	return (int_t)(m->base ? cols : rows);
+}
+
+
+/* Elementwise operation on two matrices of equal shape, or on a matrix and
+ * a number.
+ */
+static Object *elementwise(Object *op1, Object *op2, char operator)
+{
+	size_t rows = 0, cols = 0, r = 0, c = 0, n;
+	float_t *a = NULL, *b = NULL, *e, x = 0, y = 0;
+	MatrixObject *result;
+
+	if (isMatrix(op1))
+		a = elements((MatrixObject *)op1, &rows, &cols);
+	else if (isNumber(op1))
+		x = obj_as_float(op1);
+	if (isMatrix(op2))
+		b = elements((MatrixObject *)op2, isMatrix(op1) ? &r : &rows, isMatrix(op1) ? &c : &cols);
+	else if (isNumber(op2))
+		y = obj_as_float(op2);
+
+	if ((a == NULL && !isNumber(op1)) || (b == NULL && !isNumber(op2)))
+		error(TypeError, "unsupported operand type(s) for operation %c: %s and %s", \
+						  operator, TYPENAME(op1), TYPENAME(op2));
+
+	if (a && b && (rows != r || cols != c))
+		error(ValueError, "matrix shapes %lux%lu and %lux%lu do not match", \
+						  (unsigned long)rows, (unsigned long)cols, (unsigned long)r, (unsigned long)c);
+
+	n = rows * cols;
+
+	if (operator == '/')
+		for (size_t i = 0; i < n; i++)
+			if ((b ? b[i] : y) == 0)
+				error(DivisionByZeroError);
+
+	result = matrix_create(rows, cols);
+	e = result->data;
+
+	switch (operator) {
+		case '+':
+			for (size_t i = 0; i < n; i++)
+				e[i] = (a ? a[i] : x) + (b ? b[i] : y);
+			break;
+		case '-':
+			for (size_t i = 0; i < n; i++)
+				e[i] = (a ? a[i] : x) - (b ? b[i] : y);
+			break;
+		case '*':
+			for (size_t i = 0; i < n; i++)
+				e[i] = (a ? a[i] : x) * (b ? b[i] : y);
+			break;
+		case '/':
+			for (size_t i = 0; i < n; i++)
+				e[i] = (a ? a[i] : x) / (b ? b[i] : y);
+			break;
+	}
+	return (Object *)result;
+}
+
+
+static Object *matrix_add(Object *op1, Object *op2)
+{
+	return elementwise(op1, op2, '+');
+}
+
+
+static Object *matrix_sub(Object *op1, Object *op2)
+{
+	return elementwise(op1, op2, '-');
+}
+
+
+static Object *matrix_mul(Object *op1, Object *op2)
+{
+	return elementwise(op1, op2, '*');
+}
+
+
+static Object *matrix_div(Object *op1, Object *op2)
+{
+	return elementwise(op1, op2, '/');
+}
+
+
+static Object *matrix_inv(MatrixObject *op1)
+{
+	return elementwise((Object *)op1, inttype.shared(-1), '*');
+}
+
+
+static bool matrix_equal(MatrixObject *op1, MatrixObject *op2)
+{
+	size_t rows, cols, r, c;
+	float_t *a = elements(op1, &rows, &cols);
+	float_t *b = elements(op2, &r, &c);
+
+	if (rows != r || cols != c)
+		return false;
+
+	for (size_t i = 0; i < rows * cols; i++)
+		if (a[i] != b[i])
+			return false;
+
+	return true;
+}
+
+
+static bool contains(MatrixObject *m, float_t value)
+{
+	size_t rows, cols;
+	float_t *e = elements(m, &rows, &cols);
+
+	for (size_t i = 0; i < rows * cols; i++)
+		if (e[i] == value)
+			return true;
+
+	return false;
+}
+
+
+/* c = a * b, for a n x k matrix a and a k x m matrix b.
+ *
+ * The product is computed per block of KBLOCK rows and JBLOCK columns of
+ * b, so the block stays in the cache while it is used for all rows of a.
+ * Four rows of c are computed at the same time, so every element of b
+ * which is loaded is used four times. The inner loops run over contiguous
+ * elements and can be vectorized by the C compiler.
+ */
+static void multiply(const float_t *restrict a, const float_t *restrict b, float_t *restrict c, \
+					 size_t n, size_t k, size_t m)
+{
+	size_t i, j, p, kend, jend;
+
+	memset(c, 0, n * m * sizeof(float_t));
+
+	for (size_t kk = 0; kk < k; kk += KBLOCK) {
+		kend = kk + KBLOCK < k ? kk + KBLOCK : k;
+		for (size_t jj = 0; jj < m; jj += JBLOCK) {
+			jend = jj + JBLOCK < m ? jj + JBLOCK : m;
+			for (i = 0; i + 4 <= n; i += 4) {
+				float_t *restrict c0 = c + i * m, *restrict c1 = c0 + m;
+				float_t *restrict c2 = c1 + m, *restrict c3 = c2 + m;
+				for (p = kk; p < kend; p++) {
+					const float_t *restrict bp = b + p * m;
+					float_t a0 = a[i * k + p], a1 = a[(i + 1) * k + p];
+					float_t a2 = a[(i + 2) * k + p], a3 = a[(i + 3) * k + p];
+					for (j = jj; j < jend; j++) {
+						c0[j] += a0 * bp[j];
+						c1[j] += a1 * bp[j];
+						c2[j] += a2 * bp[j];
+						c3[j] += a3 * bp[j];
+					}
+				}
+			}
+			for (; i < n; i++) {  /* remaining rows */
+				float_t *restrict c0 = c + i * m;
+				for (p = kk; p < kend; p++) {
+					const float_t *restrict bp = b + p * m;
+					float_t a0 = a[i * k + p];
+					for (j = jj; j < jend; j++)
+						c0[j] += a0 * bp[j];
+				}
+			}
+		}
+	}
+}
+
+
+/* Method: matrix.dot(matrix)
+ */
+static Object *method_dot(Object *self, Object **argv)
+{
+	Object *other = isListNode(argv[0]) ? obj_from_listnode(argv[0]) : argv[0];
+	size_t n, k, r, m;
+	float_t *a, *b;
+	MatrixObject *c;
+
+	if (!isMatrix(other))
+		error(TypeError, "dot() argument must be a matrix, not %s", TYPENAME(other));
+
+	a = elements((MatrixObject *)self, &n, &k);
+	b = elements((MatrixObject *)other, &r, &m);
+
+	if (k != r)
+		error(ValueError, "matrix shapes %lux%lu and %lux%lu do not match for dot()", \
+						  (unsigned long)n, (unsigned long)k, (unsigned long)r, (unsigned long)m);
+
+	c = matrix_create(n, m);
+	if (n && m)
+		multiply(a, b, c->data, n, k, m);
+
+	obj_decref(argv[0]);
+
+	return (Object *)c;
+}
+
+
+/* Method: matrix.transpose()
+ */
+static Object *method_transpose(Object *self, Object **argv)
+{
+	size_t rows, cols;
+	float_t *a = elements((MatrixObject *)self, &rows, &cols);
+	MatrixObject *t = matrix_create(cols, rows);
+
+	for (size_t ii = 0; ii < rows; ii += TBLOCK)
+		for (size_t jj = 0; jj < cols; jj += TBLOCK)
+			for (size_t i = ii; i < ii + TBLOCK && i < rows; i++)
+				for (size_t j = jj; j < jj + TBLOCK && j < cols; j++)
+					t->data[j * rows + i] = a[i * cols + j];
+
+	return (Object *)t;
+}
+
+
+/* Method: matrix.reshape(rows, cols)
+ */
+static Object *method_reshape(Object *self, Object **argv)
+{
+	int_t r = obj_as_int(argv[0]), c = obj_as_int(argv[1]);
+	size_t rows, cols;
+	float_t *a = elements((MatrixObject *)self, &rows, &cols);
+	MatrixObject *m;
+
+	obj_decref(argv[0]);
+	obj_decref(argv[1]);
+
+	if (r < 0 || c < 0 || (size_t)r * (size_t)c != rows * cols)
+		error(ValueError, "cannot reshape %lu elements to %ldx%ld", \
+						  (unsigned long)(rows * cols), (long)r, (long)c);
+
+	m = matrix_create((size_t)r, (size_t)c);
+	if (rows && cols)
+		memcpy(m->data, a, rows * cols * sizeof(float_t));
+
+	return (Object *)m;
+}
+
+
+/* Method: matrix.len
+ */
+static Object *method_len(Object *self, Object **argv)
+{
+	return inttype.shared(size((MatrixObject *)self));
+}
+
+
+/* Method: matrix.rows
+ */
+static Object *method_rows(Object *self, Object **argv)
+{
+	size_t rows, cols;
+
+	elements((MatrixObject *)self, &rows, &cols);
+
+	return inttype.shared((int_t)rows);
+}
+
+
+/* Method: matrix.cols
+ */
+static Object *method_cols(Object *self, Object **argv)
+{
+	size_t rows, cols;
+
+	elements((MatrixObject *)self, &rows, &cols);
+
+	return inttype.shared((int_t)cols);
+}
+
+
+static Method matrixmethod[] = {
+	{"cols", method_cols, NOARGLIST},
+	{"dot", method_dot, 1},
+	{"len", method_len, NOARGLIST},
+	{"reshape", method_reshape, 2},
+	{"rows", method_rows, NOARGLIST},
+	{"transpose", method_transpose, 0},
+	{NULL}
+};
+
+static MethodTable matrixmethods = { .method = matrixmethod };
+
+
+/* Matrix object API.
+ */
+MatrixType matrixtype = {
+	.name = "matrix",
+	.alloc = (Object *(*)())matrix_alloc,
+	.free = (void (*)(Object *))matrix_free,
+	.print = (void (*)(Object *))matrix_print,
+	.set = (Object *(*)())matrix_set,
+	.vset = (Object *(*)(Object *, va_list))matrix_vset,
+	.methods = &matrixmethods,
+
+	.create = matrix_create,
+	.item = matrix_item,
+	.store = matrix_store,
+	.add = matrix_add,
+	.sub = matrix_sub,
+	.mul = matrix_mul,
+	.div = matrix_div,
+	.inv = matrix_inv,
+
+	.size = size,
+	.contains = contains,
+	.equal = matrix_equal
+	};
@@ -0,0 +1,48 @@
+/* matrix.h
+ *
+ * A matrix is a two-dimensional array of floats. The elements are stored
+ * row by row in one contiguous block of memory. Indexing a matrix returns
+ * a row view; a matrix of one row which uses the data of the matrix it
+ * was taken from (flag OBJ_VIEW is set). Indexing a row view returns an
+ * element, so m[i][j] is element j of row i. Assigning to a row view or to
+ * one of its elements changes the matrix. A row view refers to its matrix
+ * by row number, so it remains valid when the matrix gets new data.
+ *
+ * 2020	K.W.E. de Lange
+ */
+#ifndef _MATRIX_
+#define _MATRIX_
+
+#include <stdbool.h>
+
+#include "object.h"
+
+typedef struct matrixobject {
+	OBJ_HEAD;
+	size_t rows;
+	size_t cols;
+	float_t *data;				/* rows * cols elements, row by row */
+	struct matrixobject *base;	/* for a row view the matrix it was taken from, else NULL */
+	size_t row;					/* for a row view the row number in base */
+} MatrixObject;
+
+typedef struct {
+	TYPE_HEAD;
+	MatrixObject *(*create)(size_t rows, size_t cols);
+	Object *(*item)(MatrixObject *m, int index);
+	bool (*store)(MatrixObject *row, int index, float_t value);
+	Object *(*add)(Object *op1, Object *op2);
+	Object *(*sub)(Object *op1, Object *op2);
+	Object *(*mul)(Object *op1, Object *op2);
+	Object *(*div)(Object *op1, Object *op2);
+	Object *(*inv)(MatrixObject *op1);
+
+	/* raw versions for internal use, no result object is created */
+	int_t (*size)(MatrixObject *m);
+	bool (*contains)(MatrixObject *m, float_t value);
+	bool (*equal)(MatrixObject *op1, MatrixObject *op2);
+} MatrixType;
+
+extern MatrixType matrixtype;
+
+#endif
@@ -0,0 +1,170 @@
+/* native.c
+ *
+ * Native extension modules.
+ *
+ * A module whose name ends in .so, .dylib or .dll does not contain EXIN
+ * code but is a shared library with functions written in C. Importing it
+ * loads the library and calls its function exin_init(), which adds the
+ * functions in the library to the builtins (see function.c). From then on
+ * they are called like any other builtin. See exin.h for the interface and
+ * extensions/sample.c for an example.
+ *
+ * The library does not link against the interpreter. The interpreter
+ * functions it may use are handed to exin_init() in an ExinAPI struct, so
+ * the interpreter needs no special linker options. Like EXIN modules a
+ * library is only loaded once, and it is never unloaded.
+ *
+ * 2020	K.W.E. de Lange
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "function.h"
+#include "object.h"
+#include "strdup.h"
+#include "native.h"
+#include "error.h"
+#include "exin.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <dlfcn.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+
+
+typedef int (*init_t)(const ExinAPI *api);  /* exin_init() */
+
+static struct library {
+	char *name;
+	struct library *next;
+} *libraries = NULL;  /* names of the libraries which were loaded */
+
+
+static const char *type(Object *obj)
+{
+	return TYPENAME(isListNode(obj) ? obj_from_listnode(obj) : obj);
+}
+
+
+static Object *none(void)
+{
+	return obj_alloc(NONE_T);
+}
+
+
+static void incref(Object *obj)
+{
+	obj_incref(obj);
+}
+
+
+static void decref(Object *obj)
+{
+	obj_decref(obj);
+}
+
+
+/* The interpreter functions available to an extension.
+ */
+static const ExinAPI api = {
+	.version = EXIN_API_VERSION,
+
+	.builtin = builtin_register,
+	.error = error,
+
+	.type = type,
+	.as_char = obj_as_char,
+	.as_int = obj_as_int,
+	.as_float = obj_as_float,
+	.as_str = obj_as_str,
+	.as_bool = obj_as_bool,
+	.length = obj_length,
+
+	.new_char = obj_new_char,
+	.new_int = obj_new_int,
+	.new_float = obj_new_float,
+	.new_str = obj_new_str,
+	.new_str_n = obj_new_str_n,
+	.none = none,
+
+	.incref = incref,
+	.decref = decref
+	};
+
+
+/* Check if filename is a native extension module.
+ */
+bool isnative(const char *filename)
+{
+	static const char *extension[] = { ".so", ".dylib", ".dll" };
+	size_t len = strlen(filename);
+
+	for (size_t i = 0; i < sizeof extension / sizeof extension[0]; i++)
+		if (len > strlen(extension[i]) && \
+			strcmp(filename + len - strlen(extension[i]), extension[i]) == 0)
+			return true;
+
+	return false;
+}
+
+
+/* Load the shared library in filename and return the address of its
+ * exin_init() function.
+ */
+static init_t load(const char *filename)
+{
+	init_t init = NULL;
+
+#if defined(__unix__) || defined(__APPLE__)
+	char path[FILENAME_MAX];
+	void *handle;
+
+	/* without a '/' dlopen() would search the system library paths */
+	snprintf(path, sizeof path, "%s%s", strchr(filename, '/') ? "" : "./", filename);
+
+	if ((handle = dlopen(path, RTLD_NOW | RTLD_LOCAL)) == NULL)
+		error(SystemError, "cannot load %s: %s", filename, dlerror());
+
+	*(void **)&init = dlsym(handle, "exin_init");
+#elif defined(_WIN32)
+	HMODULE handle;
+
+	if ((handle = LoadLibrary(filename)) == NULL)
+		error(SystemError, "cannot load %s", filename);
+
+	init = (init_t)GetProcAddress(handle, "exin_init");
+#else
+	error(SystemError, "cannot load %s: native modules are not supported", filename);
+#endif
+
+	if (init == NULL)
+		error(SystemError, "%s has no function exin_init", filename);
+
+	return init;
+}
+
+
+/* Import a native extension module. Importing a library is only done once.
+ *
+ * filename     name of the shared library
+ */
+void native_import(const char *filename)
+{
+	struct library *lib;
+
+	for (lib = libraries; lib; lib = lib->next)
+		if (strcmp(lib->name, filename) == 0)
+			return;
+
+	if ((lib = calloc(1, sizeof(struct library))) == NULL)
+		error(OutOfMemoryError);
+	if ((lib->name = strdup(filename)) == NULL)
+		error(OutOfMemoryError);
+
+	lib->next = libraries;
+	libraries = lib;
+
+	if (load(filename)(&api) != 0)
+		error(SystemError, "initialization of %s failed", filename);
+}
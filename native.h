@@ -0,0 +1,13 @@
+/* native.h
+ *
+ * 2020	K.W.E. de Lange
+ */
+#ifndef _NATIVE_
+#define _NATIVE_
+
+#include <stdbool.h>
+
+extern bool isnative(const char *filename);
+extern void native_import(const char *filename);
+
+#endif
@@ -1,388 +1,758 @@
-/* number.c
- *
- * Number object (CHAR, INTEGER, FLOAT) operations
- *
- * 2016 K.W.E. de Lange
- */
-#include <stdlib.h>
-
-#include "number.h"
-#include "error.h"
-
-
-static Object *char_alloc(void)
-{
-	CharObject *obj;
-
-	if ((obj = calloc(1, sizeof(CharObject))) == NULL)
-		error(OutOfMemoryError);
-
-	obj->typeobj = (TypeObject *)&chartype;
-	obj->type = CHAR_T;
-	obj->refcount = 0;
-
-	obj->cval = 0;
-
-	return (Object *)obj;
-}
-
-
-static Object *int_alloc(void)
-{
-	IntObject *obj;
-
-	if ((obj = calloc(1, sizeof(IntObject))) == NULL)
-		error(OutOfMemoryError);
-
-	obj->typeobj = (TypeObject *)&inttype;
-	obj->type = INT_T;
-	obj->refcount = 0;
-
-	obj->ival = 0;
-
-	return (Object *)obj;
-}
-
-
-static Object *float_alloc(void)
-{
-	FloatObject *obj;
-
-	if ((obj = calloc(1, sizeof(FloatObject))) == NULL)
-		error(OutOfMemoryError);
-
-	obj->typeobj = (TypeObject *)&floattype;
-	obj->type = FLOAT_T;
-	obj->refcount = 0;
-
-	obj->fval = 0;
-
-	return (Object *)obj;
-}
-
-
-static void number_free(Object *obj)
-{
-	free(obj);
-}
-
-
-static void number_print(Object *obj)
-{
-	switch (TYPE(obj)) {
-		case CHAR_T:
-			printf("%c", obj_as_char(obj));
-			break;
-		case INT_T:
-			printf("%ld", obj_as_int(obj));
-			break;
-		case FLOAT_T:
-			printf("%.*G", 15, obj_as_float(obj));
-			break;
-		default:
-			break;
-	}
-}
-
-
-static CharObject *char_set(CharObject *obj, char_t c)
-{
-	obj->cval = c;
-
-	return obj;
-}
-
-
-static IntObject *int_set(IntObject *obj, int_t i)
-{
-	obj->ival = i;
-
-	return obj;
-}
-
-
-static FloatObject *float_set(FloatObject *obj, float_t f)
-{
-	obj->fval = f;
-
-	return obj;
-}
-
-
-static Object *number_vset(Object *obj, va_list argp)
-{
-	switch (TYPE(obj)) {
-		case CHAR_T:
-			return (Object *)char_set((CharObject *)obj, va_arg(argp, int));  /* va_arg requires at least an int */
-		case INT_T:
-			return (Object *)int_set((IntObject *)obj, va_arg(argp, int_t));
-		case FLOAT_T:
-			return (Object *)float_set((FloatObject *)obj, va_arg(argp, float_t));
-		default:
-			break;
-	}
-	return obj;
-}
-
-
-/* Determine the type of the result of an arithmetic operations using two
- * operands according to the following rules:
- *
- * FLOAT if at least one operand is FLOAT,
- * else INTEGER if at least one operand in INTEGER
- * else CHAR
- */
-static objecttype_t coerce(Object *op1, Object *op2)
-{
-	if (TYPE(op1) == FLOAT_T || TYPE(op2) == FLOAT_T)
-		return FLOAT_T;
-	else if (TYPE(op1) == INT_T || TYPE(op2) == INT_T)
-		return INT_T;
-	else
-		return CHAR_T;
-}
-
-
-static Object *number_add(Object *op1, Object *op2)
-{
-	switch (coerce(op1, op2)) {
-		case CHAR_T:
-			return obj_create(CHAR_T, obj_as_char(op1) + obj_as_char(op2));
-		case INT_T:
-			return obj_create(INT_T, obj_as_int(op1) + obj_as_int(op2));
-		case FLOAT_T:
-			return obj_create(FLOAT_T, obj_as_float(op1) + obj_as_float(op2));
-		default:
-			return NULL;
-	}
-}
-
-
-static Object *number_sub(Object *op1, Object *op2)
-{
-	switch (coerce(op1, op2)) {
-		case CHAR_T:
-			return obj_create(CHAR_T, obj_as_char(op1) - obj_as_char(op2));
-		case INT_T:
-			return obj_create(INT_T, obj_as_int(op1) - obj_as_int(op2));
-		case FLOAT_T:
-			return obj_create(FLOAT_T, obj_as_float(op1) - obj_as_float(op2));
-		default:
-			return NULL;
-	}
-}
-
-
-static Object *number_mul(Object *op1, Object *op2)
-{
-	switch (coerce(op1, op2)) {
-		case CHAR_T:
-			return obj_create(CHAR_T, obj_as_char(op1) * obj_as_char(op2));
-		case INT_T:
-			return obj_create(INT_T, obj_as_int(op1) * obj_as_int(op2));
-		case FLOAT_T:
-			return obj_create(FLOAT_T, obj_as_float(op1) * obj_as_float(op2));
-		default:
-			return NULL;
-	}
-}
-
-
-static Object *number_div(Object *op1, Object *op2)
-{
-	if (obj_as_int(op2) == 0)
-		error(DivisionByZeroError);
-
-	switch (coerce(op1, op2)) {
-		case CHAR_T:
-			return obj_create(CHAR_T, obj_as_char(op1) / obj_as_char(op2));
-		case INT_T:
-			return obj_create(INT_T, obj_as_int(op1) / obj_as_int(op2));
-		case FLOAT_T:
-			return obj_create(FLOAT_T, obj_as_float(op1) / obj_as_float(op2));
-		default:
-			return NULL;
-	}
-}
-
-
-static Object *number_mod(Object *op1, Object *op2)
-{
-	if (obj_as_int(op2) == 0)
-		error(DivisionByZeroError);
-
-	switch (coerce(op1, op2)) {
-		case CHAR_T:
-			return obj_create(CHAR_T, obj_as_char(op1) % obj_as_char(op2));
-		case INT_T:
-			return obj_create(INT_T, obj_as_int(op1) % obj_as_int(op2));
-		case FLOAT_T:
-			error(ModNotAllowedError, "%% operator only allowed on integers");
-		default:
-			return NULL;
-	}
-}
-
-
-static Object *number_inv(Object *op1)
-{
-	Object *op2, *result;
-
-	switch (TYPE(op1)) {
-		case CHAR_T:
-			op2 = obj_create(CHAR_T, (char_t)0);
-			break;
-		case INT_T:
-			op2 = obj_create(INT_T, (int_t)0);
-			break;
-		case FLOAT_T:
-			op2 = obj_create(FLOAT_T, (float_t)0);
-			break;
-		default:
-			return NULL;
-	}
-	result = obj_sub(op2, op1);
-
-	obj_decref(op2);
-
-	return result;
-}
-
-
-static Object *number_eql(Object *op1, Object *op2)
-{
-	if (TYPE(op1) == FLOAT_T || TYPE(op2) == FLOAT_T)
-		return obj_create(INT_T, (int_t)(obj_as_float(op1) == obj_as_float(op2)));
-	else if (TYPE(op1) == INT_T || TYPE(op1) == INT_T)
-		return obj_create(INT_T, (int_t)(obj_as_int(op1) == obj_as_int(op2)));
-	else
-		return obj_create(INT_T, (int_t)(obj_as_char(op1) == obj_as_char(op2)));
-}
-
-
-static Object *number_neq(Object *op1, Object *op2)
-{
-	if (TYPE(op1) == FLOAT_T || TYPE(op2) == FLOAT_T)
-		return obj_create(INT_T, (int_t)(obj_as_float(op1) != obj_as_float(op2)));
-	else if (TYPE(op1) == INT_T || TYPE(op1) == INT_T)
-		return obj_create(INT_T, (int_t)(obj_as_int(op1) != obj_as_int(op2)));
-	else
-		return obj_create(INT_T, (int_t)(obj_as_char(op1) != obj_as_char(op2)));
-}
-
-
-static Object *number_lss(Object *op1, Object *op2)
-{
-	if (TYPE(op1) == FLOAT_T || TYPE(op2) == FLOAT_T)
-		return obj_create(INT_T, (int_t)(obj_as_float(op1) < obj_as_float(op2)));
-	else if (TYPE(op1) == INT_T || TYPE(op1) == INT_T)
-		return obj_create(INT_T, (int_t)(obj_as_int(op1) < obj_as_int(op2)));
-	else
-		return obj_create(INT_T, (int_t)(obj_as_char(op1) < obj_as_char(op2)));
-}
-
-
-static Object *number_leq(Object *op1, Object *op2)
-{
-	if (TYPE(op1) == FLOAT_T || TYPE(op2) == FLOAT_T)
-		return obj_create(INT_T, (int_t)(obj_as_float(op1) <= obj_as_float(op2)));
-	else if (TYPE(op1) == INT_T || TYPE(op1) == INT_T)
-		return obj_create(INT_T, (int_t)(obj_as_int(op1) <= obj_as_int(op2)));
-	else
-		return obj_create(INT_T, (int_t)(obj_as_char(op1) <= obj_as_char(op2)));
-}
-
-
-static Object *number_gtr(Object *op1, Object *op2)
-{
-	if (TYPE(op1) == FLOAT_T || TYPE(op2) == FLOAT_T)
-		return obj_create(INT_T, (int_t)(obj_as_float(op1) > obj_as_float(op2)));
-	else if (TYPE(op1) == INT_T || TYPE(op1) == INT_T)
-		return obj_create(INT_T, (int_t)(obj_as_int(op1) > obj_as_int(op2)));
-	else
-		return obj_create(INT_T, (int_t)(obj_as_char(op1) > obj_as_char(op2)));
-}
-
-
-static Object *number_geq(Object *op1, Object *op2)
-{
-	if (TYPE(op1) == FLOAT_T || TYPE(op2) == FLOAT_T)
-		return obj_create(INT_T, (int_t)(obj_as_float(op1) >= obj_as_float(op2)));
-	else if (TYPE(op1) == INT_T || TYPE(op1) == INT_T)
-		return obj_create(INT_T, (int_t)(obj_as_int(op1) >= obj_as_int(op2)));
-	else
-		return obj_create(INT_T, (int_t)(obj_as_char(op1) >= obj_as_char(op2)));
-}
-
-
-static Object *number_or(Object *op1, Object *op2)
-{
-	return obj_create(INT_T, (int_t)(obj_as_bool(op1) || obj_as_bool(op2) ? 1 : 0));
-}
-
-
-static Object *number_and(Object *op1, Object *op2)
-{
-	return obj_create(INT_T, (int_t)(obj_as_bool(op1) && obj_as_bool(op2) ? 1 : 0));
-}
-
-
-static Object *number_negate(Object *op1)
-{
-	return obj_create(INT_T, (int_t)!obj_as_bool(op1));
-}
-
-
-/* Number object API (separate for char_t, int_t, float_t and number_t).
- */
-CharType chartype = {
-	.name = "char",
-	.alloc = char_alloc,
-	.free = number_free,
-	.print = number_print,
-	.set = (Object *(*)())char_set,
-	.vset = number_vset
-	};
-
-IntType inttype = {
-	.name = "int",
-	.alloc = int_alloc,
-	.free = number_free,
-	.print = number_print,
-	.set = (Object *(*)())int_set,
-	.vset = number_vset
-	};
-
-FloatType floattype = {
-	.name = "float",
-	.alloc = float_alloc,
-	.free = number_free,
-	.print = number_print,
-	.set = (Object *(*)())float_set,
-	.vset = number_vset
-	};
-
-NumberType numbertype = {
-	.name = "number",
-	.alloc = int_alloc,  /* number considered INT_T */
-	.free = number_free,
-	.print = number_print,
-	.set = (Object *(*)())int_set,  /* number considered INT_T */
-	.vset = number_vset,
-
-	.add = number_add,
-	.sub = number_sub,
-	.mul = number_mul,
-	.div = number_div,
-	.mod = number_mod,
-	.inv = number_inv,
-	.eql = number_eql,
-	.neq = number_neq,
-	.lss = number_lss,
-	.leq = number_leq,
-	.gtr = number_gtr,
-	.geq = number_geq,
-	.or = number_or,
-	.and = number_and,
-	.negate = number_negate
-	};
+/* number.c
+ *
+ * Number object (CHAR, INTEGER, FLOAT) operations
+ *
+ * 2016 K.W.E. de Lange
+ */
+#include <errno.h>
+#include <limits.h>
+#include <stdlib.h>
+
+#include "number.h"
+#include "bignum.h"
+#include "arena.h"
+#include "error.h"
+
+
+static Object *char_alloc(void)
+{
+	CharObject *obj;
+
+	if ((obj = arena.alloc(sizeof(CharObject))) != NULL)
+		obj->flags = OBJ_ARENA;
+	else if ((obj = calloc(1, sizeof(CharObject))) == NULL)
+		error(OutOfMemoryError);
+
+	obj->type = CHAR_T;
+	obj->refcount = 0;
+
+	obj->cval = 0;
+
+	return (Object *)obj;
+}
+
+
+static Object *int_alloc(void)
+{
+	IntObject *obj;
+
+	if ((obj = arena.alloc(sizeof(IntObject))) != NULL)
+		obj->flags = OBJ_ARENA;
+	else if ((obj = calloc(1, sizeof(IntObject))) == NULL)
+		error(OutOfMemoryError);
+
+	obj->type = INT_T;
+	obj->refcount = 0;
+
+	obj->ival = 0;
+	obj->big = NULL;
+
+	return (Object *)obj;
+}
+
+
+static Object *float_alloc(void)
+{
+	FloatObject *obj;
+
+	if ((obj = arena.alloc(sizeof(FloatObject))) != NULL)
+		obj->flags = OBJ_ARENA;
+	else if ((obj = calloc(1, sizeof(FloatObject))) == NULL)
+		error(OutOfMemoryError);
+
+	obj->type = FLOAT_T;
+	obj->refcount = 0;
+
+	obj->fval = 0;
+
+	return (Object *)obj;
+}
+
+
+/* Numbers which were allocated from the arena are released in bulk when
+ * the arena mark is released, see arena.c.
+ */
+static void number_free(Object *obj)
+{
+	if (isBigInt(obj))
+		bignum_free(((IntObject *)obj)->big);
+
+	if (!(obj->flags & OBJ_ARENA))
+		free(obj);
+}
+
+
+static void number_print(Object *obj)
+{
+	char *s;
+
+	switch (TYPE(obj)) {
+		case CHAR_T:
+			printf("%c", obj_as_char(obj));
+			break;
+		case INT_T:
+			if (isBigInt(obj)) {
+				s = bignum_to_str(((IntObject *)obj)->big);
+				printf("%s", s);
+				free(s);
+			} else
+				printf("%ld", obj_as_int(obj));
+			break;
+		case FLOAT_T:
+			printf("%.*G", 15, obj_as_float(obj));
+			break;
+		default:
+			break;
+	}
+}
+
+
+static CharObject *char_set(CharObject *obj, char_t c)
+{
+	obj->cval = c;
+
+	return obj;
+}
+
+
+static IntObject *int_set(IntObject *obj, int_t i)
+{
+	if (obj->big) {
+		bignum_free(obj->big);
+		obj->big = NULL;
+	}
+	obj->ival = i;
+
+	return obj;
+}
+
+
+static FloatObject *float_set(FloatObject *obj, float_t f)
+{
+	obj->fval = f;
+
+	return obj;
+}
+
+
+/* Shared immutable objects for all characters and for small integers.
+ *
+ * Comparisons and literals return these instead of allocating a new object.
+ * As they are shared they may never be modified, so before one is bound to
+ * an identifier or stored in a list a private copy is made (obj_promote()).
+ */
+static CharObject sharedchar[UCHAR_MAX + 1];
+static IntObject sharedint[SMALLINT_MAX - SMALLINT_MIN + 1];
+
+
+static void shared_init(void)
+{
+	for (int i = 0; i <= UCHAR_MAX; i++) {
+		sharedchar[i].refcount = SHARED_REFCOUNT;
+		sharedchar[i].type = CHAR_T;
+		sharedchar[i].flags = OBJ_SHARED;
+		sharedchar[i].cval = (char_t)i;
+	}
+	for (int_t i = SMALLINT_MIN; i <= SMALLINT_MAX; i++) {
+		sharedint[i - SMALLINT_MIN].refcount = SHARED_REFCOUNT;
+		sharedint[i - SMALLINT_MIN].type = INT_T;
+		sharedint[i - SMALLINT_MIN].flags = OBJ_SHARED;
+		sharedint[i - SMALLINT_MIN].ival = i;
+	}
+}
+
+
+/* Return the shared object for character c.
+ */
+static Object *char_shared(char_t c)
+{
+	if (sharedchar[0].type == UNDEFINED)
+		shared_init();
+
+	obj_incref(&sharedchar[(unsigned char)c]);
+
+	return (Object *)&sharedchar[(unsigned char)c];
+}
+
+
+/* Return the shared object for integer i, or a new object if i is outside
+ * the range of shared integers.
+ */
+static Object *int_shared(int_t i)
+{
+	if (i < SMALLINT_MIN || i > SMALLINT_MAX)
+		return obj_new_int(i);
+
+	if (sharedint[0].type == UNDEFINED)
+		shared_init();
+
+	obj_incref(&sharedint[i - SMALLINT_MIN]);
+
+	return (Object *)&sharedint[i - SMALLINT_MIN];
+}
+
+
+static Object *number_vset(Object *obj, va_list argp)
+{
+	switch (TYPE(obj)) {
+		case CHAR_T:
+			return (Object *)char_set((CharObject *)obj, va_arg(argp, int));  /* va_arg requires at least an int */
+		case INT_T:
+			return (Object *)int_set((IntObject *)obj, va_arg(argp, int_t));
+		case FLOAT_T:
+			return (Object *)float_set((FloatObject *)obj, va_arg(argp, float_t));
+		default:
+			break;
+	}
+	return obj;
+}
+
+
+/* Create an integer object with the value of bignum b, which is taken
+ * over by the new object. If the value fits in an int_t a normal integer
+ * object is returned, so a bignum is only used for large values.
+ */
+Object *int_from_bignum(Bignum *b)
+{
+	IntObject *obj;
+	int_t i;
+
+	if (bignum_to_int(b, &i)) {
+		bignum_free(b);
+		return obj_new_int(i);
+	}
+
+	arena.suspend();
+	obj = (IntObject *)obj_alloc(INT_T);
+	arena.resume();
+
+	obj->big = b;
+
+	return (Object *)obj;
+}
+
+
+/* Create an integer object from decimal string s, which may contain more
+ * digits than fit in an int_t.
+ */
+Object *int_from_str(const char *s)
+{
+	Bignum *b;
+	char *e;
+	long i;
+
+	errno = 0;
+
+	i = strtol(s, &e, 10);
+
+	if (*e == 0 && errno == 0)
+		return inttype.shared((int_t)i);
+
+	if ((b = bignum_from_str(s)) == NULL)
+		error(ValueError, "cannot convert %s to int", s);
+
+	return int_from_bignum(b);
+}
+
+
+/* Return the value of integer or char op as a new bignum.
+ */
+static Bignum *to_bignum(Object *op)
+{
+	if (isBigInt(op))
+		return bignum_copy(((IntObject *)op)->big);
+	else
+		return bignum_from_int(obj_as_int(op));
+}
+
+
+/* Apply bignum operation 'operation' on op1 and op2. This is the slow path
+ * for integers which are too large for an int_t, or when the result of an
+ * operation on int_t's overflows.
+ */
+static Object *bignum_operation(Object *op1, Object *op2, Bignum *(*operation)(const Bignum *, const Bignum *))
+{
+	Bignum *a = to_bignum(op1), *b = to_bignum(op2), *r;
+
+	r = operation(a, b);
+
+	bignum_free(a);
+	bignum_free(b);
+
+	return int_from_bignum(r);
+}
+
+
+/* return   -1, 0 or 1 if integer op1 is less than, equal to or greater than
+ *          integer op2, where at least one of them is a bignum
+ */
+static int bignum_comparison(Object *op1, Object *op2)
+{
+	Bignum *a = to_bignum(op1), *b = to_bignum(op2);
+	int c;
+
+	c = bignum_compare(a, b);
+
+	bignum_free(a);
+	bignum_free(b);
+
+	return c;
+}
+
+
+#if !defined(__GNUC__)
+/* Portable versions of the overflow checks, see number.h.
+ */
+bool int_add_overflow(int_t a, int_t b, int_t *r)
+{
+	if ((b > 0 && a > LONG_MAX - b) || (b < 0 && a < LONG_MIN - b))
+		return true;
+	*r = a + b;
+	return false;
+}
+
+
+bool int_sub_overflow(int_t a, int_t b, int_t *r)
+{
+	if ((b < 0 && a > LONG_MAX + b) || (b > 0 && a < LONG_MIN + b))
+		return true;
+	*r = a - b;
+	return false;
+}
+
+
+bool int_mul_overflow(int_t a, int_t b, int_t *r)
+{
+	if (a > 0) {
+		if (b > 0 ? a > LONG_MAX / b : b < LONG_MIN / a)
+			return true;
+	} else if (a < 0) {
+		if (b > 0 ? a < LONG_MIN / b : b < LONG_MAX / a)
+			return true;
+	}
+	*r = a * b;
+	return false;
+}
+#endif
+
+
+/* Determine the type of the result of an arithmetic operations using two
+ * operands according to the following rules:
+ *
+ * FLOAT if at least one operand is FLOAT,
+ * else INTEGER if at least one operand in INTEGER
+ * else CHAR
+ */
+static objecttype_t coerce(Object *op1, Object *op2)
+{
+	if (TYPE(op1) == FLOAT_T || TYPE(op2) == FLOAT_T)
+		return FLOAT_T;
+	else if (TYPE(op1) == INT_T || TYPE(op2) == INT_T)
+		return INT_T;
+	else
+		return CHAR_T;
+}
+
+
+static Object *number_add(Object *op1, Object *op2)
+{
+	int_t i;
+
+	switch (coerce(op1, op2)) {
+		case CHAR_T:
+			return obj_new_char(obj_as_char(op1) + obj_as_char(op2));
+		case INT_T:
+			if (!isBigInt(op1) && !isBigInt(op2) && !int_add_overflow(obj_as_int(op1), obj_as_int(op2), &i))
+				return obj_new_int(i);
+			return bignum_operation(op1, op2, bignum_add);
+		case FLOAT_T:
+			return obj_new_float(obj_as_float(op1) + obj_as_float(op2));
+		default:
+			return NULL;
+	}
+}
+
+
+static Object *number_sub(Object *op1, Object *op2)
+{
+	int_t i;
+
+	switch (coerce(op1, op2)) {
+		case CHAR_T:
+			return obj_new_char(obj_as_char(op1) - obj_as_char(op2));
+		case INT_T:
+			if (!isBigInt(op1) && !isBigInt(op2) && !int_sub_overflow(obj_as_int(op1), obj_as_int(op2), &i))
+				return obj_new_int(i);
+			return bignum_operation(op1, op2, bignum_sub);
+		case FLOAT_T:
+			return obj_new_float(obj_as_float(op1) - obj_as_float(op2));
+		default:
+			return NULL;
+	}
+}
+
+
+static Object *number_mul(Object *op1, Object *op2)
+{
+	int_t i;
+
+	switch (coerce(op1, op2)) {
+		case CHAR_T:
+			return obj_new_char(obj_as_char(op1) * obj_as_char(op2));
+		case INT_T:
+			if (!isBigInt(op1) && !isBigInt(op2) && !int_mul_overflow(obj_as_int(op1), obj_as_int(op2), &i))
+				return obj_new_int(i);
+			return bignum_operation(op1, op2, bignum_mul);
+		case FLOAT_T:
+			return obj_new_float(obj_as_float(op1) * obj_as_float(op2));
+		default:
+			return NULL;
+	}
+}
+
+
+static Object *number_div(Object *op1, Object *op2)
+{
+	int_t i;
+
+	if (!isBigInt(op2) && obj_as_int(op2) == 0)
+		error(DivisionByZeroError);
+
+	switch (coerce(op1, op2)) {
+		case CHAR_T:
+			return obj_new_char(obj_as_char(op1) / obj_as_char(op2));
+		case INT_T:
+			if (!isBigInt(op1) && !isBigInt(op2)) {
+				if (obj_as_int(op2) != -1)
+					return obj_new_int(obj_as_int(op1) / obj_as_int(op2));
+				if (!int_sub_overflow(0, obj_as_int(op1), &i))  /* x / -1 == -x */
+					return obj_new_int(i);
+			}
+			return bignum_operation(op1, op2, bignum_div);
+		case FLOAT_T:
+			return obj_new_float(obj_as_float(op1) / obj_as_float(op2));
+		default:
+			return NULL;
+	}
+}
+
+
+static Object *number_mod(Object *op1, Object *op2)
+{
+	if (!isBigInt(op2) && obj_as_int(op2) == 0)
+		error(DivisionByZeroError);
+
+	switch (coerce(op1, op2)) {
+		case CHAR_T:
+			return obj_new_char(obj_as_char(op1) % obj_as_char(op2));
+		case INT_T:
+			if (!isBigInt(op1) && !isBigInt(op2))  /* x % -1 is 0, but may trap in C */
+				return obj_new_int(obj_as_int(op2) == -1 ? 0 : obj_as_int(op1) % obj_as_int(op2));
+			return bignum_operation(op1, op2, bignum_mod);
+		case FLOAT_T:
+			error(ModNotAllowedError, "%% operator only allowed on integers");
+		default:
+			return NULL;
+	}
+}
+
+
+static Object *number_inv(Object *op1)
+{
+	Object *op2, *result;
+
+	switch (TYPE(op1)) {
+		case CHAR_T:
+			op2 = obj_new_char((char_t)0);
+			break;
+		case INT_T:
+			op2 = obj_new_int((int_t)0);
+			break;
+		case FLOAT_T:
+			op2 = obj_new_float((float_t)0);
+			break;
+		default:
+			return NULL;
+	}
+	result = obj_sub(op2, op1);
+
+	obj_decref(op2);
+
+	return result;
+}
+
+
+/* Check if two numbers are equal without creating a result object.
+ */
+static bool number_equal(Object *op1, Object *op2)
+{
+	if (TYPE(op1) == FLOAT_T || TYPE(op2) == FLOAT_T)
+		return obj_as_float(op1) == obj_as_float(op2);
+	else if (isBigInt(op1) || isBigInt(op2))
+		return bignum_comparison(op1, op2) == 0;
+	else if (TYPE(op1) == INT_T || TYPE(op2) == INT_T)
+		return obj_as_int(op1) == obj_as_int(op2);
+	else
+		return obj_as_char(op1) == obj_as_char(op2);
+}
+
+
+static Object *number_eql(Object *op1, Object *op2)
+{
+	return inttype.shared((int_t)number_equal(op1, op2));
+}
+
+
+static Object *number_neq(Object *op1, Object *op2)
+{
+	return inttype.shared((int_t)!number_equal(op1, op2));
+}
+
+
+static Object *number_lss(Object *op1, Object *op2)
+{
+	if (TYPE(op1) == FLOAT_T || TYPE(op2) == FLOAT_T)
+		return inttype.shared((int_t)(obj_as_float(op1) < obj_as_float(op2)));
+	else if (isBigInt(op1) || isBigInt(op2))
+		return inttype.shared((int_t)(bignum_comparison(op1, op2) < 0));
+	else if (TYPE(op1) == INT_T || TYPE(op2) == INT_T)
+		return inttype.shared((int_t)(obj_as_int(op1) < obj_as_int(op2)));
+	else
+		return inttype.shared((int_t)(obj_as_char(op1) < obj_as_char(op2)));
+}
+
+
+static Object *number_leq(Object *op1, Object *op2)
+{
+	if (TYPE(op1) == FLOAT_T || TYPE(op2) == FLOAT_T)
+		return inttype.shared((int_t)(obj_as_float(op1) <= obj_as_float(op2)));
+	else if (isBigInt(op1) || isBigInt(op2))
+		return inttype.shared((int_t)(bignum_comparison(op1, op2) <= 0));
+	else if (TYPE(op1) == INT_T || TYPE(op2) == INT_T)
+		return inttype.shared((int_t)(obj_as_int(op1) <= obj_as_int(op2)));
+	else
+		return inttype.shared((int_t)(obj_as_char(op1) <= obj_as_char(op2)));
+}
+
+
+static Object *number_gtr(Object *op1, Object *op2)
+{
+	if (TYPE(op1) == FLOAT_T || TYPE(op2) == FLOAT_T)
+		return inttype.shared((int_t)(obj_as_float(op1) > obj_as_float(op2)));
+	else if (isBigInt(op1) || isBigInt(op2))
+		return inttype.shared((int_t)(bignum_comparison(op1, op2) > 0));
+	else if (TYPE(op1) == INT_T || TYPE(op2) == INT_T)
+		return inttype.shared((int_t)(obj_as_int(op1) > obj_as_int(op2)));
+	else
+		return inttype.shared((int_t)(obj_as_char(op1) > obj_as_char(op2)));
+}
+
+
+static Object *number_geq(Object *op1, Object *op2)
+{
+	if (TYPE(op1) == FLOAT_T || TYPE(op2) == FLOAT_T)
+		return inttype.shared((int_t)(obj_as_float(op1) >= obj_as_float(op2)));
+	else if (isBigInt(op1) || isBigInt(op2))
+		return inttype.shared((int_t)(bignum_comparison(op1, op2) >= 0));
+	else if (TYPE(op1) == INT_T || TYPE(op2) == INT_T)
+		return inttype.shared((int_t)(obj_as_int(op1) >= obj_as_int(op2)));
+	else
+		return inttype.shared((int_t)(obj_as_char(op1) >= obj_as_char(op2)));
+}
+
+
+static Object *number_or(Object *op1, Object *op2)
+{
+	return inttype.shared((int_t)(obj_as_bool(op1) || obj_as_bool(op2) ? 1 : 0));
+}
+
+
+static Object *number_and(Object *op1, Object *op2)
+{
+	return inttype.shared((int_t)(obj_as_bool(op1) && obj_as_bool(op2) ? 1 : 0));
+}
+
+
+static Object *number_negate(Object *op1)
+{
+	return inttype.shared((int_t)!obj_as_bool(op1));
+}
+
+
+/* Bitwise operators are only defined for CHAR and INTEGER. The caller
+ * checks this, see obj_bitand() etc. in object.c.
+ */
+static Object *number_bitand(Object *op1, Object *op2)
+{
+	if (coerce(op1, op2) == CHAR_T)
+		return obj_new_char(obj_as_char(op1) & obj_as_char(op2));
+	else
+		return obj_new_int(obj_as_int(op1) & obj_as_int(op2));
+}
+
+
+static Object *number_bitor(Object *op1, Object *op2)
+{
+	if (coerce(op1, op2) == CHAR_T)
+		return obj_new_char(obj_as_char(op1) | obj_as_char(op2));
+	else
+		return obj_new_int(obj_as_int(op1) | obj_as_int(op2));
+}
+
+
+static Object *number_bitxor(Object *op1, Object *op2)
+{
+	if (coerce(op1, op2) == CHAR_T)
+		return obj_new_char(obj_as_char(op1) ^ obj_as_char(op2));
+	else
+		return obj_new_int(obj_as_int(op1) ^ obj_as_int(op2));
+}
+
+
+/* Shift i left by n bits. The result is stored in *r, without the bits
+ * which were shifted out.
+ *
+ * return   true if the result did not fit in an int_t
+ */
+bool int_lshift_overflow(int_t i, int_t n, int_t *r)
+{
+	if (n < 0)
+		error(ValueError, "negative shift count");
+
+	if (n >= (int_t)(sizeof(int_t) * CHAR_BIT)) {
+		*r = 0;
+		return i != 0;
+	}
+
+	*r = (int_t)((unsigned long)i << n);
+
+	return int_rshift(*r, n) != i;
+}
+
+
+/* Shift i right by n bits, keeping the sign.
+ */
+int_t int_rshift(int_t i, int_t n)
+{
+	if (n < 0)
+		error(ValueError, "negative shift count");
+
+	if (n >= (int_t)(sizeof(int_t) * CHAR_BIT))
+		return i < 0 ? -1 : 0;
+
+	return i < 0 ? ~(~i >> n) : i >> n;
+}
+
+
+/* A left shift which does not fit in an int_t is op1 * 2^op2 as bignum.
+ */
+static Object *number_lshift(Object *op1, Object *op2)
+{
+	Bignum *a, *b, *p;
+	int_t i, n = obj_as_int(op2);
+
+	if (coerce(op1, op2) == CHAR_T) {
+		int_lshift_overflow(obj_as_int(op1), n, &i);
+		return obj_new_char((char_t)i);
+	}
+
+	if (!isBigInt(op1) && !int_lshift_overflow(obj_as_int(op1), n, &i))
+		return obj_new_int(i);
+
+	a = to_bignum(op1);
+	b = bignum_from_int(2);
+	p = bignum_pow(b, (unsigned long)n);
+
+	bignum_free(b);
+	b = bignum_mul(a, p);
+
+	bignum_free(a);
+	bignum_free(p);
+
+	return int_from_bignum(b);
+}
+
+
+static Object *number_rshift(Object *op1, Object *op2)
+{
+	if (coerce(op1, op2) == CHAR_T)
+		return obj_new_char((char_t)int_rshift(obj_as_int(op1), obj_as_int(op2)));
+	else
+		return obj_new_int(int_rshift(obj_as_int(op1), obj_as_int(op2)));
+}
+
+
+static Object *number_complement(Object *op1)
+{
+	if (TYPE(op1) == CHAR_T)
+		return obj_new_char((char_t)~obj_as_char(op1));
+	else
+		return obj_new_int(~obj_as_int(op1));
+}
+
+
+/* Number object API (separate for char_t, int_t, float_t and number_t).
+ */
+CharType chartype = {
+	.name = "char",
+	.alloc = char_alloc,
+	.free = number_free,
+	.print = number_print,
+	.set = (Object *(*)())char_set,
+	.vset = number_vset,
+
+	.shared = char_shared
+	};
+
+IntType inttype = {
+	.name = "int",
+	.alloc = int_alloc,
+	.free = number_free,
+	.print = number_print,
+	.set = (Object *(*)())int_set,
+	.vset = number_vset,
+
+	.shared = int_shared
+	};
+
+FloatType floattype = {
+	.name = "float",
+	.alloc = float_alloc,
+	.free = number_free,
+	.print = number_print,
+	.set = (Object *(*)())float_set,
+	.vset = number_vset
+	};
+
+NumberType numbertype = {
+	.name = "number",
+	.alloc = int_alloc,  /* number considered INT_T */
+	.free = number_free,
+	.print = number_print,
+	.set = (Object *(*)())int_set,  /* number considered INT_T */
+	.vset = number_vset,
+
+	.add = number_add,
+	.sub = number_sub,
+	.mul = number_mul,
+	.div = number_div,
+	.mod = number_mod,
+	.inv = number_inv,
+	.eql = number_eql,
+	.neq = number_neq,
+	.lss = number_lss,
+	.leq = number_leq,
+	.gtr = number_gtr,
+	.geq = number_geq,
+	.or = number_or,
+	.and = number_and,
+	.negate = number_negate,
+	.bitand = number_bitand,
+	.bitor = number_bitor,
+	.bitxor = number_bitxor,
+	.lshift = number_lshift,
+	.rshift = number_rshift,
+	.complement = number_complement,
+
+	.equal = number_equal
+	};
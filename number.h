@@ -1,74 +1,115 @@
-/* number.h
- *
- * 2016 K.W.E. de Lange
- */
-#ifndef _NUMBER_
-#define _NUMBER_
-
-#include "object.h"
-
-typedef struct {
-	OBJ_HEAD;
-	char_t cval;
-} CharObject;
-
-typedef struct {
-	OBJ_HEAD;
-	int_t ival;
-} IntObject;
-
-typedef struct {
-	OBJ_HEAD;
-	float_t fval;
-} FloatObject;
-
-typedef struct {
-	OBJ_HEAD;
-	objecttype_t numbertype;
-	union {
-		char_t cval;
-		int_t ival;
-		float_t fval;
-	} value;
-} NumberObject;
-
-typedef struct {
-	TYPE_HEAD;
-} CharType;
-
-extern CharType chartype;
-
-typedef struct {
-	TYPE_HEAD;
-} IntType;
-
-extern IntType inttype;
-
-typedef struct {
-	TYPE_HEAD;
-} FloatType;
-
-extern FloatType floattype;
-
-typedef struct {
-	TYPE_HEAD;
-	Object *(*add)(Object *op1, Object *op2);
-	Object *(*sub)(Object *op1, Object *op2);
-	Object *(*mul)(Object *op1, Object *op2);
-	Object *(*div)(Object *op1, Object *op2);
-	Object *(*mod)(Object *op1, Object *op2);
-	Object *(*inv)(Object *op1);
-	Object *(*eql)(Object *op1, Object *op2);
-	Object *(*neq)(Object *op1, Object *op2);
-	Object *(*lss)(Object *op1, Object *op2);
-	Object *(*leq)(Object *op1, Object *op2);
-	Object *(*gtr)(Object *op1, Object *op2);
-	Object *(*geq)(Object *op1, Object *op2);
-	Object *(*or)(Object *op1, Object *op2);
-	Object *(*and)(Object *op1, Object *op2);
-	Object *(*negate)(Object *op1);
-} NumberType;
-
-extern NumberType numbertype;
-
-#endif
+/* number.h
+ *
+ * 2016 K.W.E. de Lange
+ */
+#ifndef _NUMBER_
+#define _NUMBER_
+
+#include "object.h"
+
+/* Range of integers for which shared objects exist, see inttype.shared()
+ */
+#define SMALLINT_MIN	-5
+#define SMALLINT_MAX	256
+
+typedef struct {
+	OBJ_HEAD;
+	char_t cval;
+} CharObject;
+
+/* An integer whose value does not fit in an int_t is kept in a bignum
+ * (see bignum.c), and ival is then not used. Integer objects with a bignum
+ * are always allocated from the heap, never from the arena.
+ */
+typedef struct {
+	OBJ_HEAD;
+	int_t ival;
+	struct bignum *big;	/* NULL if the value fits in ival */
+} IntObject;
+
+#define isBigInt(obj)	(TYPE(obj) == INT_T && ((IntObject *)(obj))->big != NULL)
+
+typedef struct {
+	OBJ_HEAD;
+	float_t fval;
+} FloatObject;
+
+typedef struct {
+	OBJ_HEAD;
+	objecttype_t numbertype;
+	union {
+		char_t cval;
+		int_t ival;
+		float_t fval;
+	} value;
+} NumberObject;
+
+typedef struct {
+	TYPE_HEAD;
+	Object *(*shared)(char_t c);
+} CharType;
+
+extern CharType chartype;
+
+typedef struct {
+	TYPE_HEAD;
+	Object *(*shared)(int_t i);
+} IntType;
+
+extern IntType inttype;
+
+typedef struct {
+	TYPE_HEAD;
+} FloatType;
+
+extern FloatType floattype;
+
+typedef struct {
+	TYPE_HEAD;
+	Object *(*add)(Object *op1, Object *op2);
+	Object *(*sub)(Object *op1, Object *op2);
+	Object *(*mul)(Object *op1, Object *op2);
+	Object *(*div)(Object *op1, Object *op2);
+	Object *(*mod)(Object *op1, Object *op2);
+	Object *(*inv)(Object *op1);
+	Object *(*eql)(Object *op1, Object *op2);
+	Object *(*neq)(Object *op1, Object *op2);
+	Object *(*lss)(Object *op1, Object *op2);
+	Object *(*leq)(Object *op1, Object *op2);
+	Object *(*gtr)(Object *op1, Object *op2);
+	Object *(*geq)(Object *op1, Object *op2);
+	Object *(*or)(Object *op1, Object *op2);
+	Object *(*and)(Object *op1, Object *op2);
+	Object *(*negate)(Object *op1);
+	Object *(*bitand)(Object *op1, Object *op2);
+	Object *(*bitor)(Object *op1, Object *op2);
+	Object *(*bitxor)(Object *op1, Object *op2);
+	Object *(*lshift)(Object *op1, Object *op2);
+	Object *(*rshift)(Object *op1, Object *op2);
+	Object *(*complement)(Object *op1);
+
+	bool (*equal)(Object *op1, Object *op2);
+} NumberType;
+
+extern NumberType numbertype;
+
+extern bool int_lshift_overflow(int_t i, int_t n, int_t *r);
+extern int_t int_rshift(int_t i, int_t n);
+
+extern Object *int_from_bignum(struct bignum *b);
+extern Object *int_from_str(const char *s);
+
+/* Integer arithmetic which reports overflow. The result is stored in *r and
+ * the return value is true if it did not fit in an int_t.
+ */
+#if defined(__GNUC__)
+#define int_add_overflow(a, b, r)	__builtin_add_overflow(a, b, r)
+#define int_sub_overflow(a, b, r)	__builtin_sub_overflow(a, b, r)
+#define int_mul_overflow(a, b, r)	__builtin_mul_overflow(a, b, r)
+#else
+extern bool int_add_overflow(int_t a, int_t b, int_t *r);
+extern bool int_sub_overflow(int_t a, int_t b, int_t *r);
+extern bool int_mul_overflow(int_t a, int_t b, int_t *r);
+#endif
+
+#endif
@@ -1,30 +1,71 @@
-/* reader.h
- *
- * 2018	K.W.E. de Lange
- */
-#ifndef _READER_
-#define _READER_
-
-#include "module.h"
-
-typedef struct reader {
-	struct module *current;	/* currently reading from this module */
-	char *pos;				/* position of next character to read */
-	char *bol;				/* position of beginning of current line */
-
-	int (*nextch)(void);	/* read the next character */
-	int (*peekch)(void);	/* peek the next character */
-	int (*pushch)(int);		/* push character back in the input stream */
-	void (*to_bol)(void);	/* move to beginning of current line */
-	void (*reset)(void);	/* reset reader to line 1, character 1 */
-
-	void (*init)(struct reader *);			/* initialize reader struct */
-	struct positionobject *(*save)(void);	/* save current reader */
-	void (*jump)(struct positionobject *);	/* load current reader */
-	int (*import)(const char *filename);	/* import new module */
-	void (*print_current_line)(void);		/* print current line */
-} Reader;
-
-extern Reader reader;
-
-#endif
+/* reader.h
+ *
+ * 2018	K.W.E. de Lange
+ */
+#ifndef _READER_
+#define _READER_
+
+#include <assert.h>
+#include <stdio.h>
+
+#include "module.h"
+
+typedef struct reader {
+	struct module *current;	/* currently reading from this module */
+	char *pos;				/* position of next character to read */
+	char *bol;				/* position of beginning of current line */
+
+	int (*nextch)(void);	/* read the next character */
+	int (*peekch)(void);	/* peek the next character */
+	int (*pushch)(int);		/* push character back in the input stream */
+	void (*to_bol)(void);	/* move to beginning of current line */
+	void (*reset)(void);	/* reset reader to line 1, character 1 */
+
+	void (*init)(struct reader *);			/* initialize reader struct */
+	struct positionobject *(*save)(void);	/* save current reader */
+	void (*jump)(struct positionobject *);	/* load current reader */
+	int (*import)(const char *filename);	/* import new module */
+	void (*print_current_line)(void);		/* print current line */
+} Reader;
+
+extern Reader reader;
+
+/* Direct-call versions of reader.nextch(), reader.peekch() and
+ * reader.pushch(). The scanner calls these for every character, so they
+ * are inlined instead of being called via a function pointer.
+ */
+static inline int reader_nextch(void)
+{
+	if (*reader.pos == 0) {
+		reader.bol = reader.pos;
+		return EOF;
+	} else {
+		if (reader.pos > reader.current->code && *(reader.pos - 1) == '\n')
+			reader.bol = reader.pos;
+		return (unsigned int)*reader.pos++;
+	}
+}
+
+
+static inline int reader_peekch(void)
+{
+	if (*reader.pos == 0)
+		return EOF;
+	else
+		return (unsigned int)*reader.pos;
+}
+
+
+/* Note: this implementation only puts the read pointer back one position
+ * and does nothing with ch. Properly this should be done via a stack.
+ */
+static inline int reader_pushch(const int ch)
+{
+	if (reader.pos > reader.current->code && ch != EOF) {
+		reader.pos--;
+		assert(*reader.pos == (char)ch);
+	}
+	return ch;
+}
+
+#endif
@@ -0,0 +1,1096 @@
+/* regexp.c
+ *
+ * Regular expressions without backtracking.
+ *
+ * A pattern is parsed into a syntax tree, which is translated into two
+ * nondeterministic automata (NFA): one which reads the input forwards and
+ * one which reads it backwards. A deterministic automaton (DFA) is built
+ * from an NFA while matching; a DFA state is a set of NFA states, and it
+ * and its transitions are only created when the input reaches them. After
+ * a few characters most transitions are known, and matching costs a table
+ * lookup per character. When a DFA grows too large its states are thrown
+ * away and built again. Every character of the input is read a fixed
+ * number of times, so matching time is linear in the length of the input
+ * whatever the pattern.
+ *
+ * Supported syntax:
+ *
+ *   c        character c; special characters .[]()|*+?{}^$\ need a \
+ *   .        any character except newline
+ *   [abc]    any of the characters, ranges like a-z are allowed
+ *   [^abc]   any character except those listed
+ *   \d \w \s digit, word character [A-Za-z0-9_] and white space;
+ *   \D \W \S the capitals mean the opposite
+ *   \n \t \r \f \v  control characters
+ *   ^ $      start and end of the string
+ *   (r)      group, (?:r) is the same
+ *   r|s      r or s
+ *   r* r+ r? zero or more, one or more, zero or one times r
+ *   r{m} r{m,} r{m,n}  m times, at least m times, m up to n times r
+ *
+ * Of the matches starting at the same position the longest is taken
+ * (like POSIX, unlike Perl which takes the first alternative that fits).
+ * Groups only group, their matches are not recorded.
+ *
+ * Finding where a match starts needs a second pass. The forward DFA first
+ * checks if there is a match at all; this is all the work for a string
+ * which does not match. If there is one the backward DFA reads the string
+ * from end to start and marks every position where a match starts, and
+ * the forward DFA finds the longest match from the leftmost of these.
+ * Findall does the latter for every match; the part of the input which was
+ * read in vain is remembered so it is not read again (see longest()).
+ *
+ * Compiled patterns are cached by pattern string, see regexp_compile().
+ *
+ * 2020	K.W.E. de Lange
+ */
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "strdup.h"
+#include "error.h"
+#include "regexp.h"
+
+#define MAXREPEAT	1000	/* maximum m and n in r{m,n} */
+#define MAXNSTATES	10000	/* maximum number of NFA states per automaton */
+#define MAXDSTATES	2000	/* DFA states which are kept before starting again */
+#define BUCKETS		1024	/* size of the hash table with DFA states, power of 2 */
+#define CACHESIZE	64		/* number of compiled patterns kept */
+
+
+/* Set of characters, one bit per character.
+ */
+typedef struct {
+	uint32_t bits[8];
+} Set;
+
+#define set_has(s, c)	((s)->bits[(unsigned char)(c) >> 5] & (1u << ((unsigned char)(c) & 31)))
+#define set_add(s, c)	((s)->bits[(unsigned char)(c) >> 5] |= (1u << ((unsigned char)(c) & 31)))
+
+
+/* Syntax tree node.
+ */
+typedef enum { N_EMPTY, N_SET, N_BOL, N_EOL, N_CAT, N_ALT, N_REPEAT } nodekind_t;
+
+typedef struct {
+	nodekind_t kind;
+	int set;			/* N_SET: index of character set */
+	int min, max;		/* N_REPEAT: number of times, max -1 is unlimited */
+	int left, right;	/* N_CAT, N_ALT: operands; N_REPEAT: left is repeated */
+} Node;
+
+
+/* NFA state.
+ */
+typedef enum { S_MATCH, S_SET, S_SPLIT, S_BOL, S_EOL } statekind_t;
+
+typedef struct {
+	statekind_t kind;
+	int set;			/* S_SET: index of character set */
+	int out, out1;		/* next state(s); S_SPLIT continues in both */
+} NState;
+
+typedef struct {
+	NState *state;
+	int nstates;
+	int maxstates;
+	int start;
+} NFA;
+
+
+/* DFA state. The kernel consists of the NFA states which were reached by
+ * the last character read, the DFA state is the set of NFA states which
+ * can be reached from there without reading a character.
+ */
+typedef struct dstate {
+	struct dstate *chain;	/* next state in the same hash bucket */
+	struct dstate **next;	/* transition per character class, NULL if not yet known */
+	bool begin;				/* true if no character was read yet, so ^ matches */
+	bool accept;			/* true if a match ends here */
+	bool accept_end;		/* true if a match ends here if it is the end of the string */
+	bool dead;				/* true if no match is possible anymore */
+	int n;					/* number of NFA states in kernel */
+	int kernel[];
+} DState;
+
+typedef struct {
+	struct regexp *re;
+	NFA *nfa;
+	bool unanchored;		/* a match can start at every position */
+	DState *bucket[BUCKETS];
+	DState *start[2];		/* start state, index is 'begin' */
+	int nstates;
+	bool flushed;			/* states were thrown away during the last lookup */
+	unsigned flushes;		/* number of times the states were thrown away */
+	unsigned generation;	/* for marking NFA states, see mark[] */
+	unsigned *mark;
+	int *stack, *list, *kernel;
+} DFA;
+
+
+/* Pairs of a DFA state and a position in the input from which no match
+ * can end anymore, see longest(). Kept in a hash table with open addressing.
+ */
+typedef struct {
+	const DState *d;	/* NULL for an empty slot */
+	size_t pos;
+} Failure;
+
+typedef struct {
+	Failure *slot;
+	size_t size;			/* number of slots, power of 2 */
+	size_t count;			/* number of slots in use */
+	size_t horizon;			/* there are no failures beyond this position */
+	unsigned flushes;		/* DFA flushes when the failures were recorded */
+	const DState **trail;	/* states read since the last match ended */
+} Memo;
+
+
+struct regexp {
+	char *pattern;
+	Set *set;
+	int nsets;
+	unsigned char class[256];	/* characters which behave the same share a class */
+	int nclasses;
+	NFA forward, backward;
+	DFA search;		/* forward, unanchored: is there a match */
+	DFA longest;	/* forward, anchored: longest match from a position */
+	DFA starts;		/* backward, unanchored: positions where matches start */
+};
+
+
+/* Pattern parser.
+ */
+typedef struct {
+	const char *pattern;
+	const char *p;		/* next character to read */
+	Node *node;
+	int nnodes;
+	int maxnodes;
+	Set *set;
+	int nsets;
+	int maxsets;
+} Parser;
+
+
+static void syntax_error(Parser *ps, const char *reason)
+{
+	error(ValueError, "invalid regular expression %s: %s at position %d", \
+					   ps->pattern, reason, (int)(ps->p - ps->pattern));
+}
+
+
+static int new_node(Parser *ps, nodekind_t kind, int left, int right)
+{
+	if (ps->nnodes == ps->maxnodes) {
+		ps->maxnodes = ps->maxnodes ? ps->maxnodes * 2 : 32;
+		if ((ps->node = realloc(ps->node, ps->maxnodes * sizeof(Node))) == NULL)
+			error(OutOfMemoryError);
+	}
+	ps->node[ps->nnodes] = (Node){ .kind = kind, .left = left, .right = right };
+
+	return ps->nnodes++;
+}
+
+
+static int new_set(Parser *ps)
+{
+	if (ps->nsets == ps->maxsets) {
+		ps->maxsets = ps->maxsets ? ps->maxsets * 2 : 16;
+		if ((ps->set = realloc(ps->set, ps->maxsets * sizeof(Set))) == NULL)
+			error(OutOfMemoryError);
+	}
+	memset(&ps->set[ps->nsets], 0, sizeof(Set));
+
+	return ps->nsets++;
+}
+
+
+static int set_node(Parser *ps, int set)
+{
+	int n = new_node(ps, N_SET, -1, -1);
+
+	ps->node[n].set = set;
+
+	return n;
+}
+
+
+static void set_range(Set *s, int from, int to)
+{
+	for (int c = from; c <= to; c++)
+		set_add(s, c);
+}
+
+
+static void set_invert(Set *s)
+{
+	for (int i = 0; i < 8; i++)
+		s->bits[i] = ~s->bits[i];
+}
+
+
+/* Read the character after a \ and add it to set s.
+ *
+ * return   the character, or -1 if it was a class like \d
+ */
+static int escape(Parser *ps, Set *s)
+{
+	Set class = { {0} };
+	int c = (unsigned char)*ps->p++;
+
+	switch (c) {
+		case 'n': c = '\n'; break;
+		case 't': c = '\t'; break;
+		case 'r': c = '\r'; break;
+		case 'f': c = '\f'; break;
+		case 'v': c = '\v'; break;
+		case 'd': case 'D':
+			set_range(&class, '0', '9');
+			break;
+		case 'w': case 'W':
+			set_range(&class, 'a', 'z');
+			set_range(&class, 'A', 'Z');
+			set_range(&class, '0', '9');
+			set_add(&class, '_');
+			break;
+		case 's': case 'S':
+			set_add(&class, ' ');
+			set_range(&class, '\t', '\r');  /* \t \n \v \f \r */
+			break;
+		case '\0':
+			ps->p--;
+			syntax_error(ps, "\\ at end of pattern");
+			break;
+		default:
+			if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')) {
+				ps->p--;
+				syntax_error(ps, "unknown escape");
+			}
+			break;
+	}
+
+	if (c != 'd' && c != 'D' && c != 'w' && c != 'W' && c != 's' && c != 'S') {
+		set_add(s, c);
+		return c;
+	}
+
+	if (c == 'D' || c == 'W' || c == 'S')
+		set_invert(&class);
+
+	for (int i = 0; i < 8; i++)
+		s->bits[i] |= class.bits[i];
+
+	return -1;
+}
+
+
+/* Read a character class. The opening [ has already been read.
+ */
+static int character_class(Parser *ps)
+{
+	int set = new_set(ps), from, to;
+	bool invert = false;
+	Set s = { {0} };
+
+	if (*ps->p == '^') {
+		invert = true;
+		ps->p++;
+	}
+
+	do {  /* a ] right after [ or [^ is an ordinary character */
+		if (*ps->p == '\0')
+			syntax_error(ps, "missing ]");
+
+		if (*ps->p == '\\') {
+			ps->p++;
+			if ((from = escape(ps, &s)) < 0)
+				continue;
+		} else {
+			from = (unsigned char)*ps->p++;
+			set_add(&s, from);
+		}
+
+		if (ps->p[0] == '-' && ps->p[1] != ']' && ps->p[1] != '\0') {
+			ps->p++;
+			if (*ps->p == '\\') {
+				ps->p++;
+				if ((to = escape(ps, &s)) < 0)
+					syntax_error(ps, "bad character range");
+			} else
+				to = (unsigned char)*ps->p++;
+			if (to < from)
+				syntax_error(ps, "bad character range");
+			set_range(&s, from, to);
+		}
+	} while (*ps->p != ']');
+
+	ps->p++;
+
+	if (invert)
+		set_invert(&s);
+
+	ps->set[set] = s;
+
+	return set_node(ps, set);
+}
+
+
+static int alternation(Parser *ps);
+
+
+static int atom(Parser *ps)
+{
+	int n, set;
+
+	switch (*ps->p) {
+		case '(':
+			ps->p++;
+			if (ps->p[0] == '?' && ps->p[1] == ':')
+				ps->p += 2;
+			n = alternation(ps);
+			if (*ps->p != ')')
+				syntax_error(ps, "missing )");
+			ps->p++;
+			return n;
+		case '[':
+			ps->p++;
+			return character_class(ps);
+		case '.':
+			ps->p++;
+			set = new_set(ps);
+			set_range(&ps->set[set], 0, 255);
+			ps->set[set].bits['\n' >> 5] &= ~(1u << ('\n' & 31));
+			return set_node(ps, set);
+		case '^':
+			ps->p++;
+			return new_node(ps, N_BOL, -1, -1);
+		case '$':
+			ps->p++;
+			return new_node(ps, N_EOL, -1, -1);
+		case '\\':
+			ps->p++;
+			set = new_set(ps);
+			escape(ps, &ps->set[set]);
+			return set_node(ps, set);
+		case '*': case '+': case '?':
+			syntax_error(ps, "nothing to repeat");
+			return -1;
+		default:
+			set = new_set(ps);
+			set_add(&ps->set[set], *ps->p);
+			ps->p++;
+			return set_node(ps, set);
+	}
+}
+
+
+/* Read a number for a repetition count.
+ */
+static int count(Parser *ps)
+{
+	int n = 0;
+
+	while (*ps->p >= '0' && *ps->p <= '9') {
+		n = n * 10 + *ps->p++ - '0';
+		if (n > MAXREPEAT)
+			syntax_error(ps, "repetition count too large");
+	}
+	return n;
+}
+
+
+/* Check if {m}, {m,} or {m,n} follows. If not a { is an ordinary character.
+ */
+static bool is_repetition(const char *p)
+{
+	if (*p++ != '{' || *p < '0' || *p > '9')
+		return false;
+
+	while (*p >= '0' && *p <= '9')
+		p++;
+
+	if (*p == ',')
+		while (*++p >= '0' && *p <= '9')
+			;
+
+	return *p == '}';
+}
+
+
+static int repetition(Parser *ps)
+{
+	int n = atom(ps), min, max;
+
+	while (1) {
+		if (*ps->p == '*')
+			min = 0, max = -1;
+		else if (*ps->p == '+')
+			min = 1, max = -1;
+		else if (*ps->p == '?')
+			min = 0, max = 1;
+		else if (is_repetition(ps->p)) {
+			ps->p++;
+			min = max = count(ps);
+			if (*ps->p == ',') {
+				ps->p++;
+				max = (*ps->p == '}') ? -1 : count(ps);
+			}
+			if (max != -1 && max < min)
+				syntax_error(ps, "bad repetition count");
+		} else
+			return n;
+
+		ps->p++;
+
+		n = new_node(ps, N_REPEAT, n, -1);
+		ps->node[n].min = min;
+		ps->node[n].max = max;
+	}
+}
+
+
+static int concatenation(Parser *ps)
+{
+	int n = new_node(ps, N_EMPTY, -1, -1);
+
+	while (*ps->p != '\0' && *ps->p != '|' && *ps->p != ')')
+		if (ps->node[n].kind == N_EMPTY)
+			n = repetition(ps);
+		else
+			n = new_node(ps, N_CAT, n, repetition(ps));
+
+	return n;
+}
+
+
+static int alternation(Parser *ps)
+{
+	int n = concatenation(ps);
+
+	while (*ps->p == '|') {
+		ps->p++;
+		n = new_node(ps, N_ALT, n, concatenation(ps));
+	}
+	return n;
+}
+
+
+/* Divide the characters in classes. Two characters are in the same class
+ * if every set in the pattern contains both or neither of them. The DFA
+ * then needs a transition per class instead of per character.
+ */
+static void character_classes(Regexp *re)
+{
+	unsigned char old[256];
+	int map[256 * 2];
+
+	memset(re->class, 0, sizeof(re->class));
+	re->nclasses = 1;
+
+	for (int s = 0; s < re->nsets; s++) {
+		memcpy(old, re->class, sizeof(old));
+		for (int i = 0; i < 256 * 2; i++)
+			map[i] = -1;
+		re->nclasses = 0;
+		for (int c = 0; c < 256; c++) {
+			int key = old[c] * 2 + (set_has(&re->set[s], c) ? 1 : 0);
+			if (map[key] < 0)
+				map[key] = re->nclasses++;
+			re->class[c] = (unsigned char)map[key];
+		}
+	}
+}
+
+
+static int new_state(NFA *nfa, statekind_t kind, int out, int out1)
+{
+	if (nfa->nstates == MAXNSTATES)
+		error(ValueError, "regular expression too large");
+
+	if (nfa->nstates == nfa->maxstates) {
+		nfa->maxstates = nfa->maxstates ? nfa->maxstates * 2 : 32;
+		if ((nfa->state = realloc(nfa->state, nfa->maxstates * sizeof(NState))) == NULL)
+			error(OutOfMemoryError);
+	}
+	nfa->state[nfa->nstates] = (NState){ .kind = kind, .out = out, .out1 = out1 };
+
+	return nfa->nstates++;
+}
+
+
+/* Translate node n and everything below it into NFA states. The states
+ * are created from the end to the start, so the state to continue with
+ * after n is always known.
+ *
+ * next     state to continue with after n has matched
+ * backward if true the NFA reads the input from end to start
+ * return   first state of n
+ */
+static int build(NFA *nfa, Node *node, int n, int next, bool backward)
+{
+	Node *x = &node[n];
+	int s, entry;
+
+	switch (x->kind) {
+		case N_EMPTY:
+			return next;
+		case N_SET:
+			s = new_state(nfa, S_SET, next, -1);
+			nfa->state[s].set = x->set;
+			return s;
+		case N_BOL:  /* reading backwards the start of the string is the end */
+			return new_state(nfa, backward ? S_EOL : S_BOL, next, -1);
+		case N_EOL:
+			return new_state(nfa, backward ? S_BOL : S_EOL, next, -1);
+		case N_CAT:
+			if (backward)
+				return build(nfa, node, x->right, build(nfa, node, x->left, next, backward), backward);
+			return build(nfa, node, x->left, build(nfa, node, x->right, next, backward), backward);
+		case N_ALT:
+			s = build(nfa, node, x->left, next, backward);
+			return new_state(nfa, S_SPLIT, s, build(nfa, node, x->right, next, backward));
+		case N_REPEAT:
+			entry = next;
+			if (x->max == -1) {
+				entry = new_state(nfa, S_SPLIT, -1, next);
+				s = build(nfa, node, x->left, entry, backward);
+				nfa->state[entry].out = s;
+			} else
+				for (int i = x->min; i < x->max; i++) {
+					s = build(nfa, node, x->left, entry, backward);
+					entry = new_state(nfa, S_SPLIT, s, next);
+				}
+			for (int i = 0; i < x->min; i++)
+				entry = build(nfa, node, x->left, entry, backward);
+			return entry;
+	}
+	return next;
+}
+
+
+/* Mark NFA state i as visited while following the states from a kernel.
+ *
+ * return   true if it was not visited before
+ */
+static inline bool visit(DFA *dfa, int i)
+{
+	if (dfa->mark[i] == dfa->generation)
+		return false;
+
+	dfa->mark[i] = dfa->generation;
+
+	return true;
+}
+
+
+/* Forget which NFA states were visited.
+ */
+static void unvisit(DFA *dfa)
+{
+	if (++dfa->generation == 0) {
+		memset(dfa->mark, 0, dfa->nfa->nstates * sizeof(unsigned));
+		dfa->generation = 1;
+	}
+}
+
+
+/* Find the NFA states which can be reached from a kernel without reading
+ * a character. Their states which read a character are stored in
+ * dfa->list.
+ *
+ * begin    true if ^ matches
+ * end      true if $ matches
+ * accept   is set to true if a match was reached
+ * return   number of states in dfa->list
+ */
+static int closure(DFA *dfa, const int *kernel, int n, bool begin, bool end, bool *accept)
+{
+	NState *state = dfa->nfa->state;
+	int sp = 0, count = 0, i;
+
+	unvisit(dfa);
+	*accept = false;
+
+	for (i = 0; i < n; i++)
+		if (visit(dfa, kernel[i]))
+			dfa->stack[sp++] = kernel[i];
+
+	while (sp) {
+		i = dfa->stack[--sp];
+		switch (state[i].kind) {
+			case S_MATCH:
+				*accept = true;
+				break;
+			case S_SET:
+				dfa->list[count++] = i;
+				break;
+			case S_SPLIT:
+				if (visit(dfa, state[i].out1))
+					dfa->stack[sp++] = state[i].out1;
+				if (visit(dfa, state[i].out))
+					dfa->stack[sp++] = state[i].out;
+				break;
+			case S_BOL:
+			case S_EOL:
+				if ((state[i].kind == S_BOL ? begin : end) && visit(dfa, state[i].out))
+					dfa->stack[sp++] = state[i].out;
+				break;
+		}
+	}
+	return count;
+}
+
+
+/* Throw away all DFA states.
+ */
+static void flush(DFA *dfa)
+{
+	DState *d, *next;
+
+	for (int i = 0; i < BUCKETS; i++) {
+		for (d = dfa->bucket[i]; d; d = next) {
+			next = d->chain;
+			free(d->next);
+			free(d);
+		}
+		dfa->bucket[i] = NULL;
+	}
+	dfa->start[0] = dfa->start[1] = NULL;
+	dfa->nstates = 0;
+	dfa->flushed = true;
+	dfa->flushes++;
+}
+
+
+/* Find the DFA state for a kernel, create it if it does not exist yet.
+ *
+ * kernel   sorted NFA state numbers
+ */
+static DState *lookup(DFA *dfa, const int *kernel, int n, bool begin)
+{
+	uint32_t h = 2166136261u ^ begin;  /* FNV-1a */
+	DState **bucket, *d;
+
+	for (int i = 0; i < n; i++)
+		h = (h ^ (uint32_t)kernel[i]) * 16777619u;
+
+	bucket = &dfa->bucket[h & (BUCKETS - 1)];
+
+	for (d = *bucket; d; d = d->chain)
+		if (d->n == n && d->begin == begin && memcmp(d->kernel, kernel, n * sizeof(int)) == 0)
+			return d;
+
+	if (dfa->nstates == MAXDSTATES)
+		flush(dfa);
+
+	if ((d = malloc(sizeof(DState) + n * sizeof(int))) == NULL)
+		error(OutOfMemoryError);
+
+	if ((d->next = calloc(dfa->re->nclasses, sizeof(DState *))) == NULL)
+		error(OutOfMemoryError);
+
+	memcpy(d->kernel, kernel, n * sizeof(int));
+	d->n = n;
+	d->begin = begin;
+	d->dead = (n == 0);
+	closure(dfa, d->kernel, n, begin, false, &d->accept);
+	closure(dfa, d->kernel, n, begin, true, &d->accept_end);
+
+	d->chain = *bucket;
+	*bucket = d;
+	dfa->nstates++;
+
+	return d;
+}
+
+
+static DState *start_state(DFA *dfa, bool begin)
+{
+	if (dfa->start[begin] == NULL)
+		dfa->start[begin] = lookup(dfa, &dfa->nfa->start, 1, begin);
+
+	return dfa->start[begin];
+}
+
+
+static int compare(const void *a, const void *b)
+{
+	return *(const int *)a - *(const int *)b;
+}
+
+
+/* Determine the DFA state which follows state d after reading c.
+ */
+static DState *step(DFA *dfa, DState *d, unsigned char c)
+{
+	NState *state = dfa->nfa->state, *s;
+	int count, n = 0;
+	DState *next;
+	bool accept;
+
+	count = closure(dfa, d->kernel, d->n, d->begin, false, &accept);
+
+	unvisit(dfa);
+
+	for (int i = 0; i < count; i++) {
+		s = &state[dfa->list[i]];
+		if (set_has(&dfa->re->set[s->set], c) && visit(dfa, s->out))
+			dfa->kernel[n++] = s->out;
+	}
+
+	if (dfa->unanchored && visit(dfa, dfa->nfa->start))
+		dfa->kernel[n++] = dfa->nfa->start;
+
+	qsort(dfa->kernel, n, sizeof(int), compare);
+
+	dfa->flushed = false;
+	next = lookup(dfa, dfa->kernel, n, false);
+
+	if (!dfa->flushed)  /* else d no longer exists */
+		d->next[dfa->re->class[c]] = next;
+
+	return next;
+}
+
+
+static inline DState *advance(DFA *dfa, DState *d, unsigned char c)
+{
+	DState *next = d->next[dfa->re->class[c]];
+
+	return next ? next : step(dfa, d, c);
+}
+
+
+static void dfa_init(DFA *dfa, Regexp *re, NFA *nfa, bool unanchored)
+{
+	size_t n = nfa->nstates;
+
+	memset(dfa, 0, sizeof(DFA));
+
+	dfa->re = re;
+	dfa->nfa = nfa;
+	dfa->unanchored = unanchored;
+
+	dfa->mark = calloc(n, sizeof(unsigned));
+	dfa->stack = calloc(n, sizeof(int));
+	dfa->list = calloc(n, sizeof(int));
+	dfa->kernel = calloc(n, sizeof(int));
+
+	if (!dfa->mark || !dfa->stack || !dfa->list || !dfa->kernel)
+		error(OutOfMemoryError);
+}
+
+
+static void dfa_free(DFA *dfa)
+{
+	flush(dfa);
+	free(dfa->mark);
+	free(dfa->stack);
+	free(dfa->list);
+	free(dfa->kernel);
+}
+
+
+static Regexp *compile(const char *pattern)
+{
+	Parser ps = { .pattern = pattern, .p = pattern };
+	Regexp *re;
+	int root;
+
+	root = alternation(&ps);
+
+	if (*ps.p == ')')
+		syntax_error(&ps, "unbalanced )");
+
+	if ((re = calloc(1, sizeof(Regexp))) == NULL)
+		error(OutOfMemoryError);
+
+	if ((re->pattern = strdup(pattern)) == NULL)
+		error(OutOfMemoryError);
+
+	re->set = ps.set;
+	re->nsets = ps.nsets;
+
+	character_classes(re);
+
+	re->forward.start = build(&re->forward, ps.node, root, \
+							  new_state(&re->forward, S_MATCH, -1, -1), false);
+	re->backward.start = build(&re->backward, ps.node, root, \
+							   new_state(&re->backward, S_MATCH, -1, -1), true);
+	free(ps.node);
+
+	dfa_init(&re->search, re, &re->forward, true);
+	dfa_init(&re->longest, re, &re->forward, false);
+	dfa_init(&re->starts, re, &re->backward, true);
+
+	return re;
+}
+
+
+static void regexp_free(Regexp *re)
+{
+	dfa_free(&re->search);
+	dfa_free(&re->longest);
+	dfa_free(&re->starts);
+	free(re->forward.state);
+	free(re->backward.state);
+	free(re->set);
+	free(re->pattern);
+	free(re);
+}
+
+
+/* Return the compiled version of a pattern.
+ *
+ * The CACHESIZE most recently used patterns are kept (one per hash value),
+ * so a pattern which is used in a loop is compiled only once. The DFA
+ * states which were built while matching are kept as well.
+ */
+Regexp *regexp_compile(const char *pattern)
+{
+	static Regexp *cache[CACHESIZE];
+	uint32_t h = 2166136261u;
+	Regexp **slot;
+
+	for (const char *p = pattern; *p; p++)
+		h = (h ^ (unsigned char)*p) * 16777619u;
+
+	slot = &cache[h % CACHESIZE];
+
+	if (*slot && strcmp((*slot)->pattern, pattern) == 0)
+		return *slot;
+
+	if (*slot)
+		regexp_free(*slot);
+
+	*slot = NULL;  /* compile() may raise an error */
+
+	return *slot = compile(pattern);
+}
+
+
+/* Check if a match ends anywhere in s.
+ */
+static bool found(Regexp *re, const unsigned char *s, size_t len)
+{
+	DFA *dfa = &re->search;
+	DState *d = start_state(dfa, true);
+
+	for (size_t i = 0; i < len; i++) {
+		if (d->accept)
+			return true;
+		d = advance(dfa, d, s[i]);
+	}
+	return d->accept_end;
+}
+
+
+static size_t memo_hash(const Memo *memo, const DState *d, size_t pos)
+{
+	uint32_t h = (uint32_t)((uintptr_t)d >> 4) * 2654435761u ^ (uint32_t)pos * 2246822519u;
+
+	return (h ^ (h >> 15)) & (memo->size - 1);
+}
+
+
+static bool memo_has(const Memo *memo, const DState *d, size_t pos)
+{
+	Failure *f;
+
+	if (memo->count == 0 || pos > memo->horizon)
+		return false;
+
+	for (size_t i = memo_hash(memo, d, pos); (f = &memo->slot[i])->d; i = (i + 1) & (memo->size - 1))
+		if (f->d == d && f->pos == pos)
+			return true;
+
+	return false;
+}
+
+
+static void memo_add(Memo *memo, const DState *d, size_t pos)
+{
+	Failure *old = memo->slot;
+	size_t size = memo->size, i;
+
+	if (2 * (memo->count + 1) > memo->size) {  /* keep the table at most half full */
+		memo->size = size ? size * 2 : 64;
+		if ((memo->slot = calloc(memo->size, sizeof(Failure))) == NULL)
+			error(OutOfMemoryError);
+		memo->count = 0;
+		for (i = 0; i < size; i++)
+			if (old[i].d)
+				memo_add(memo, old[i].d, old[i].pos);
+		free(old);
+	}
+
+	for (i = memo_hash(memo, d, pos); memo->slot[i].d; i = (i + 1) & (memo->size - 1))
+		;
+
+	memo->slot[i] = (Failure){ .d = d, .pos = pos };
+	memo->count++;
+
+	if (pos > memo->horizon)
+		memo->horizon = pos;
+}
+
+
+static void memo_clear(Memo *memo)
+{
+	if (memo->slot)
+		memset(memo->slot, 0, memo->size * sizeof(Failure));
+
+	memo->count = 0;
+	memo->horizon = 0;
+}
+
+
+/* Find the longest match which starts at position 'from'.
+ *
+ * Reading on after the last match may go up to the end of the input, for
+ * example for a|a.*b. When this is done for every match, as findall does,
+ * the time becomes quadratic. Therefore, if memo is not NULL, the states
+ * read after the last match are recorded there together with their
+ * positions. Reading from such a pair again cannot lead to a match, so a
+ * next call stops as soon as it reaches one. Every pair is recorded once,
+ * so all calls together read every character a limited number of times
+ * (maximal munch as by T. Reps, 1998).
+ *
+ * memo     failures of earlier calls on the same input, may be NULL
+ * return   end of the match, -1 if there is none
+ */
+static long longest(Regexp *re, const unsigned char *s, size_t len, size_t from, Memo *memo)
+{
+	DFA *dfa = &re->longest;
+	DState *d = start_state(dfa, from == 0);
+	size_t i, first = from, n = 0;
+	long end = -1;
+
+	for (i = from; !d->dead; i++) {
+		if (memo) {
+			if (memo->flushes != dfa->flushes) {  /* recorded states no longer exist */
+				memo_clear(memo);
+				memo->flushes = dfa->flushes;
+				n = 0;
+			}
+			if (memo_has(memo, d, i))
+				break;
+		}
+		if (i == len ? d->accept_end : d->accept) {
+			end = (long)i;
+			n = 0;
+		} else if (memo) {
+			if (n == 0)
+				first = i;
+			memo->trail[n++] = d;
+		}
+		if (i == len)
+			break;
+		d = advance(dfa, d, s[i]);
+	}
+
+	for (i = 0; i < n; i++)
+		memo_add(memo, memo->trail[i], first + i);
+
+	return end;
+}
+
+
+/* Read s from end to start and find the positions where a match starts.
+ *
+ * mark     array of len + 1 flags which are set to true if a match starts
+ *          at that position, may be NULL
+ * return   leftmost position where a match starts, len if there is none
+ */
+static size_t starts(Regexp *re, const unsigned char *s, size_t len, bool *mark)
+{
+	DFA *dfa = &re->starts;
+	DState *d = start_state(dfa, true);
+	size_t leftmost = len, i = len;
+	bool accept;
+
+	while (1) {
+		accept = i ? d->accept : d->accept_end;
+		if (mark)
+			mark[i] = accept;
+		if (accept)
+			leftmost = i;
+		if (i == 0)
+			break;
+		d = advance(dfa, d, s[--i]);
+	}
+	return leftmost;
+}
+
+
+/* Check if the whole string s matches.
+ */
+bool regexp_match(Regexp *re, const char *s, size_t len)
+{
+	return longest(re, (const unsigned char *)s, len, 0, NULL) == (long)len;
+}
+
+
+/* Find the leftmost match in s, and of the matches starting there the longest.
+ *
+ * return   true if a match was found
+ */
+bool regexp_search(Regexp *re, const char *s, size_t len, RegexpMatch *match)
+{
+	const unsigned char *u = (const unsigned char *)s;
+
+	if (!found(re, u, len))
+		return false;
+
+	match->start = starts(re, u, len, NULL);
+	match->end = (size_t)longest(re, u, len, match->start, NULL);
+
+	return true;
+}
+
+
+/* Find all non-overlapping matches in s, from left to right. An empty
+ * match directly after another match is allowed.
+ *
+ * match    receives an array with the matches which the caller must free,
+ *          NULL if there are none
+ * return   number of matches
+ */
+size_t regexp_findall(Regexp *re, const char *s, size_t len, RegexpMatch **match)
+{
+	const unsigned char *u = (const unsigned char *)s;
+	Memo memo = { .flushes = re->longest.flushes };
+	size_t n = 0, size = 0;
+	bool *mark;
+	long end;
+
+	*match = NULL;
+
+	if (!found(re, u, len))
+		return 0;
+
+	if ((mark = malloc(len + 1)) == NULL || (memo.trail = malloc((len + 1) * sizeof(DState *))) == NULL)
+		error(OutOfMemoryError);
+
+	starts(re, u, len, mark);
+
+	for (size_t i = 0; i <= len; i++) {
+		if (!mark[i] || (end = longest(re, u, len, i, &memo)) < (long)i)
+			continue;
+		if (n == size) {
+			size = size ? size * 2 : 16;
+			if ((*match = realloc(*match, size * sizeof(RegexpMatch))) == NULL)
+				error(OutOfMemoryError);
+		}
+		(*match)[n++] = (RegexpMatch){ .start = i, .end = (size_t)end };
+		if ((size_t)end > i)
+			i = (size_t)end - 1;
+	}
+	free(mark);
+	free(memo.trail);
+	free(memo.slot);
+
+	return n;
+}
@@ -0,0 +1,23 @@
+/* regexp.h
+ *
+ * 2020	K.W.E. de Lange
+ */
+#ifndef _REGEXP_
+#define _REGEXP_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct regexp Regexp;
+
+typedef struct {
+	size_t start;	/* index of the first character of the match */
+	size_t end;		/* index of the first character after the match */
+} RegexpMatch;
+
+extern Regexp *regexp_compile(const char *pattern);
+extern bool regexp_match(Regexp *re, const char *s, size_t len);
+extern bool regexp_search(Regexp *re, const char *s, size_t len, RegexpMatch *match);
+extern size_t regexp_findall(Regexp *re, const char *s, size_t len, RegexpMatch **match);
+
+#endif
@@ -0,0 +1,83 @@
+/* rng.c
+ *
+ * Pseudo random number generator xoshiro256** by D. Blackman and
+ * S. Vigna (see https://prng.di.unimi.it). It is fast, has a period of
+ * 2^256 - 1 and passes all common statistical tests. It is not suitable
+ * for cryptography.
+ *
+ * All state is kept in a Generator struct, so independent generators can
+ * exist next to each other.
+ *
+ * 2020	K.W.E. de Lange
+ */
+#include "rng.h"
+
+
+static inline uint64_t rotl(const uint64_t x, int k)
+{
+	return (x << k) | (x >> (64 - k));
+}
+
+
+/* Initialize generator g. The state is filled from seed using splitmix64,
+ * so similar seeds still give unrelated sequences.
+ */
+void rng_seed(Generator *g, uint64_t seed)
+{
+	uint64_t z;
+
+	for (int i = 0; i < 4; i++) {
+		z = (seed += 0x9E3779B97F4A7C15u);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9u;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBu;
+		g->s[i] = z ^ (z >> 31);
+	}
+}
+
+
+/* Return the next 64 random bits.
+ */
+uint64_t rng_next(Generator *g)
+{
+	uint64_t *s = g->s;
+	const uint64_t result = rotl(s[1] * 5, 7) * 9;
+	const uint64_t t = s[1] << 17;
+
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = rotl(s[3], 45);
+
+	return result;
+}
+
+
+/* Return a random float in the range [0, 1).
+ */
+float_t rng_float(Generator *g)
+{
+	return (float_t)(rng_next(g) >> 11) * (1.0 / 9007199254740992.0);  /* 2^53 */
+}
+
+
+/* Return a random integer in the range [a, b], a <= b. Values from the top
+ * of the 64 bit range which would make some results more likely than others
+ * are rejected.
+ */
+int_t rng_range(Generator *g, int_t a, int_t b)
+{
+	uint64_t range = (uint64_t)b - (uint64_t)a + 1, limit, x;
+
+	if (range == 0)  /* a and b span the full 64 bit range */
+		return (int_t)rng_next(g);
+
+	limit = UINT64_MAX - UINT64_MAX % range;
+
+	do
+		x = rng_next(g);
+	while (x >= limit);
+
+	return (int_t)((uint64_t)a + x % range);
+}
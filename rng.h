@@ -0,0 +1,21 @@
+/* rng.h
+ *
+ * 2020	K.W.E. de Lange
+ */
+#ifndef _RNG_
+#define _RNG_
+
+#include <stdint.h>
+
+#include "config.h"
+
+typedef struct {
+	uint64_t s[4];	/* state, never all 0 */
+} Generator;
+
+extern void rng_seed(Generator *g, uint64_t seed);
+extern uint64_t rng_next(Generator *g);
+extern float_t rng_float(Generator *g);
+extern int_t rng_range(Generator *g, int_t a, int_t b);
+
+#endif
@@ -0,0 +1,399 @@
+/* runtime.c
+ *
+ * Support functions for programs which were translated to C by the
+ * compiler (see compiler.c).
+ *
+ * Translated code uses the same objects and object operations as the
+ * interpreter. Only the bookkeeping which the interpreter does while
+ * reading the code is done here instead.
+ *
+ * In the interpreter temporary objects are allocated from the arena and
+ * released at the end of every statement. Translated code does not use the
+ * arena. Instead every temporary object is pushed on a stack, and at the end
+ * of a statement the references on the stack are released in one go up to
+ * the mark which was set at the start of the statement.
+ *
+ * 2020	K.W.E. de Lange
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "runtime.h"
+#include "matrix.h"
+#include "bytes.h"
+
+
+static Object **stack = NULL;	/* temporary objects */
+static size_t top = 0;			/* number of objects on the stack */
+static size_t size = 0;			/* number of slots in the stack */
+
+
+/* Return the current top of the stack with temporary objects.
+ */
+size_t rt_mark(void)
+{
+	return top;
+}
+
+
+/* Release all temporary objects which were pushed since mark.
+ */
+void rt_release(size_t mark)
+{
+	Object *obj;
+
+	while (top > mark)
+		if ((obj = stack[--top]) != NULL)
+			obj_decref(obj);
+}
+
+
+/* Push a temporary object. The callers reference is taken over.
+ */
+Object *rt_temp(Object *obj)
+{
+	if (top == size) {
+		size = size ? size * 2 : 256;
+		if ((stack = realloc(stack, size * sizeof(Object *))) == NULL)
+			error(OutOfMemoryError);
+	}
+	stack[top++] = obj;
+
+	return obj;
+}
+
+
+/* Take the reference to a temporary object back from the stack.
+ *
+ * return   obj, the caller now owns a reference
+ */
+Object *rt_claim(Object *obj)
+{
+	for (size_t i = top; i-- > 0; )
+		if (stack[i] == obj) {
+			stack[i] = NULL;
+			if (i == top - 1)
+				top--;
+			return obj;
+		}
+
+	obj_incref(obj);
+
+	return obj;
+}
+
+
+/* Get an object which can be stored in a list.
+ */
+Object *rt_arg(Object *obj)
+{
+	return obj_take(rt_claim(obj));
+}
+
+
+/* Get an object which can be passed as argument to a function.
+ */
+Object *rt_pass(Object *obj)
+{
+	return obj_pass(rt_claim(obj));
+}
+
+
+/* Read a variable. A variable which has not been declared yet is NULL.
+ */
+Object *rt_use(Object *var, const char *name)
+{
+	if (var == NULL)
+		error(NameError, "identifier %s is not defined", name);
+
+	obj_incref(var);
+
+	return rt_temp(var);
+}
+
+
+/* Bind an object to a variable, see identifier.bind().
+ */
+void rt_bind(Object **var, Object *obj)
+{
+	Object *old = *var;
+
+	*var = obj_promote(obj);
+
+	if (old)
+		obj_decref(old);
+}
+
+
+/* Declare a variable of a certain type and assign an optional initial value,
+ * see variable_declaration() in parser.c.
+ *
+ * init     initial value on the stack with temporary objects, or NULL
+ */
+void rt_declare(Object **var, objecttype_t type, Object *init)
+{
+	if (init && TYPE(init) == type && (init->refcount == 1 || (init->flags & OBJ_SHARED)) \
+		&& !(init->flags & OBJ_VIEW))
+		rt_bind(var, rt_claim(init));
+	else {
+		rt_bind(var, obj_alloc(type));
+		if (init)
+			obj_assign(*var, init);
+	}
+}
+
+
+/* Read a value for a variable from stdin, see input_stmnt() in parser.c.
+ */
+void rt_input(Object **var, const char *name)
+{
+	if (*var == NULL)
+		error(NameError, "identifier %s undeclared", name);
+
+	rt_bind(var, obj_scan(TYPE(*var)));
+}
+
+
+/* Read a temporary object of a certain type from stdin.
+ */
+Object *rt_scan(objecttype_t type)
+{
+	return rt_temp(obj_scan(type));
+}
+
+
+/* Release the object bound to a variable when leaving its scope.
+ */
+void rt_drop(Object *var)
+{
+	if (var)
+		obj_decref(var);
+}
+
+
+/* Convert the return value of a module to an exit code, see parser().
+ */
+int rt_exit(Object *obj)
+{
+	int r = 0;
+
+	if (obj) {
+		if (isNumber(obj))
+			r = (int)obj_as_int(obj);
+		obj_decref(obj);
+	}
+	return r;
+}
+
+
+/* Create temporary objects.
+ */
+Object *rt_int(int_t i)
+{
+	return rt_temp(inttype.shared(i));
+}
+
+
+Object *rt_float(float_t f)
+{
+	return rt_temp(obj_new_float(f));
+}
+
+
+Object *rt_char(char_t c)
+{
+	return rt_temp(chartype.shared(c));
+}
+
+
+Object *rt_str(const char *s)
+{
+	return rt_temp(obj_new_str(s));
+}
+
+
+Object *rt_list(void)
+{
+	return rt_temp(obj_alloc(LIST_T));
+}
+
+
+Object *rt_none(void)
+{
+	return rt_temp(obj_alloc(NONE_T));
+}
+
+
+/* Arithmetic on unboxed numbers with the same checks as in number.c.
+ */
+void rt_overflow(void)
+{
+	error(ValueError, "integer overflow in translated code");
+}
+
+
+int_t rt_idiv(int_t op1, int_t op2)
+{
+	if (op2 == 0)
+		error(DivisionByZeroError);
+
+	if (op2 == -1)
+		return rt_isub(0, op1);
+
+	return op1 / op2;
+}
+
+
+int_t rt_imod(int_t op1, int_t op2)
+{
+	if (op2 == 0)
+		error(DivisionByZeroError);
+
+	return op2 == -1 ? 0 : op1 % op2;
+}
+
+
+float_t rt_fdiv(float_t op1, float_t op2)
+{
+	if ((int_t)op2 == 0)
+		error(DivisionByZeroError);
+
+	return op1 / op2;
+}
+
+
+/* Check if an object is a number, also when stored in a list.
+ */
+bool rt_isnum(Object *obj)
+{
+	obj = isListNode(obj) ? obj_from_listnode(obj) : obj;
+
+	return isNumber(obj);
+}
+
+
+/* Shared objects may not be modified, so return a private copy of obj
+ * when it is about to be assigned to. See assignment_expr().
+ */
+Object *rt_private(Object *obj)
+{
+	if ((obj->flags & OBJ_SHARED) && TYPE(obj) != NONE_T)
+		return rt_temp(obj_copy(obj));
+
+	return obj;
+}
+
+
+/* Compound assignment: lvalue = lvalue op rvalue
+ */
+void rt_update(Object *lvalue, Object *(*op)(Object *, Object *), Object *rvalue)
+{
+	Object *result;
+
+	result = op(lvalue, rvalue);
+	obj_assign(lvalue, result);
+	obj_decref(result);
+}
+
+
+/* Check if a subscript may follow obj, see subscript() in expression.c.
+ */
+Object *rt_sequence(Object *obj)
+{
+	if (!isSequence(obj))
+		error(TypeError, "%s is not subscriptable", TYPENAME(obj));
+
+	return obj;
+}
+
+
+/* Push the result of an index or slice operation, NULL means the index
+ * was out of range.
+ */
+Object *rt_index(Object *obj)
+{
+	if (obj == NULL)
+		error(IndexError);
+
+	return rt_temp(obj);
+}
+
+
+/* Temporary item = sequence[index]
+ */
+Object *rt_item(Object *sequence, int_t index)
+{
+	return rt_index(obj_item(sequence, (int)index));
+}
+
+
+/* sequence[index] = value, or sequence[index] op= value if op is not NULL.
+ *
+ * An element of a row view of a matrix or of a bytes object is stored in
+ * the matrix or bytes, see element_assignment() in expression.c.
+ *
+ * return   temporary item containing the assigned value
+ */
+Object *rt_setitem(Object *sequence, int_t index, Object *(*op)(Object *, Object *), Object *value)
+{
+	Object *item;
+
+	sequence = isListNode(sequence) ? obj_from_listnode(sequence) : sequence;
+
+	if (isBytes(sequence)) {
+		if (op)
+			value = rt_temp(op(rt_item(sequence, index), value));
+		if (bytestype.store((BytesObject *)sequence, (int)index, obj_as_int(value)) == false)
+			error(IndexError);
+		return inttype.shared(obj_as_int(value));
+	}
+
+	item = rt_private(rt_item(sequence, index));
+
+	if (op)
+		rt_update(item, op, value);
+	else
+		obj_assign(item, value);
+
+	if (isMatrix(sequence) && (sequence->flags & OBJ_VIEW))
+		matrixtype.store((MatrixObject *)sequence, (int)index, obj_as_float(item));
+
+	return item;
+}
+
+
+/* Temporary slice = sequence[start:end]
+ */
+Object *rt_slice(Object *sequence, int_t start, int_t end)
+{
+	return rt_index(obj_slice(sequence, (int)start, (int)end));
+}
+
+
+/* Call method name of obj, see method() in expression.c.
+ *
+ * argc     number of arguments, NOARGLIST if there was no argument list
+ * argv     arguments, the method takes over these references
+ * return   new reference
+ */
+Object *rt_call_method(Object *obj, const char *name, int argc, Object **argv)
+{
+	Method *m;
+
+	obj = isListNode(obj) ? obj_from_listnode(obj) : obj;
+
+	if ((m = obj_method(TYPE(obj), name)) == NULL)
+		error(SyntaxError, "unknown method %s for type %s", name, TYPENAME(obj));
+	if (argc != m->nargs)
+		error(TypeError, "%s() takes %d argument(s)", name, m->nargs);
+
+	return m->function(obj, argv);
+}
+
+
+/* Temporary item = list.remove(index)
+ */
+Object *rt_remove(Object *list, int_t index)
+{
+	return rt_index(listtype.remove((ListObject *)list, (int)index));
+}
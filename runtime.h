@@ -0,0 +1,99 @@
+/* runtime.h
+ *
+ * 2020	K.W.E. de Lange
+ */
+#ifndef _RUNTIME_
+#define _RUNTIME_
+
+#include <stdio.h>
+
+#include "object.h"
+#include "number.h"
+#include "str.h"
+#include "list.h"
+#include "function.h"
+#include "native.h"
+#include "error.h"
+
+extern size_t rt_mark(void);
+extern void rt_release(size_t mark);
+extern Object *rt_temp(Object *obj);
+extern Object *rt_claim(Object *obj);
+extern Object *rt_arg(Object *obj);
+extern Object *rt_pass(Object *obj);
+
+extern Object *rt_use(Object *var, const char *name);
+extern void rt_bind(Object **var, Object *obj);
+extern void rt_declare(Object **var, objecttype_t type, Object *init);
+extern void rt_input(Object **var, const char *name);
+extern Object *rt_scan(objecttype_t type);
+extern void rt_drop(Object *var);
+extern int rt_exit(Object *obj);
+
+extern Object *rt_int(int_t i);
+extern Object *rt_float(float_t f);
+extern Object *rt_char(char_t c);
+extern Object *rt_str(const char *s);
+extern Object *rt_list(void);
+extern Object *rt_none(void);
+
+extern void rt_overflow(void);
+extern int_t rt_idiv(int_t op1, int_t op2);
+extern int_t rt_imod(int_t op1, int_t op2);
+extern float_t rt_fdiv(float_t op1, float_t op2);
+extern bool rt_isnum(Object *obj);
+
+extern Object *rt_private(Object *obj);
+extern void rt_update(Object *lvalue, Object *(*op)(Object *, Object *), Object *rvalue);
+
+extern Object *rt_sequence(Object *obj);
+extern Object *rt_index(Object *obj);
+extern Object *rt_item(Object *sequence, int_t index);
+extern Object *rt_setitem(Object *sequence, int_t index, Object *(*op)(Object *, Object *), Object *value);
+extern Object *rt_slice(Object *sequence, int_t start, int_t end);
+extern Object *rt_call_method(Object *obj, const char *name, int argc, Object **argv);
+extern Object *rt_remove(Object *list, int_t index);
+
+/* Integer arithmetic on unboxed numbers. A C variable cannot hold a bignum,
+ * so where the interpreter would switch to a bignum this is an error.
+ */
+static inline int_t rt_iadd(int_t op1, int_t op2)
+{
+	int_t r;
+
+	if (int_add_overflow(op1, op2, &r))
+		rt_overflow();
+	return r;
+}
+
+
+static inline int_t rt_isub(int_t op1, int_t op2)
+{
+	int_t r;
+
+	if (int_sub_overflow(op1, op2, &r))
+		rt_overflow();
+	return r;
+}
+
+
+static inline int_t rt_imul(int_t op1, int_t op2)
+{
+	int_t r;
+
+	if (int_mul_overflow(op1, op2, &r))
+		rt_overflow();
+	return r;
+}
+
+
+static inline int_t rt_ilshift(int_t op1, int_t op2)
+{
+	int_t r;
+
+	if (int_lshift_overflow(op1, op2, &r))
+		rt_overflow();
+	return r;
+}
+
+#endif
@@ -1,12 +1,12 @@
-/* strndup.h
- *
- * 1994	K.W.E. de Lange
- */
-#ifndef _STRNDUP_
-#define _STRNDUP_
-
-#include <stddef.h>
-
-extern char *strndup(const char *s, size_t n);
-
+/* strndup.h
+ *
+ * 1994	K.W.E. de Lange
+ */
+#ifndef _STRNDUP_
+#define _STRNDUP_
+
+#include <stddef.h>
+
+extern char *strndup(const char *s, size_t n);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,53 @@
+#!/bin/sh
+# emitc_check.sh
+#
+# Check the translation to C. Every example is run by the interpreter and
+# as translated program, using the same input. The output on stdout and the
+# exit codes must be equal. Error messages are not compared as translated
+# programs do not show the source line where an error occurred.
+#
+# Usage (from the directory with the sources): sh tools/emitc_check.sh [exin]
+#
+# 2020	K.W.E. de Lange
+
+EXIN=$(realpath "${1:-./exin}")
+CC=${CC:-gcc}
+CFLAGS=${CFLAGS:-"-std=c99 -O2 -w"}
+SRC=$(pwd)
+TMP=$(mktemp -d)
+INPUT='hello world\nn\n\n'
+failed=0
+
+# the runtime is everything except the interpreters main program
+for f in *.c; do
+	[ "$f" = main.c ] || $CC $CFLAGS -c "$f" -o "$TMP/${f%.c}.o" || exit 1
+done
+
+cd examples
+
+for f in *.x; do
+	name=${f%.x}
+	if ! "$EXIN" --emit-c "$f" > "$TMP/$name.c" 2> "$TMP/$name.err"; then
+		echo "$f: skipped, $(tail -n 1 "$TMP/$name.err")"
+		continue
+	fi
+	if ! $CC $CFLAGS -I"$SRC" "$TMP/$name.c" "$TMP"/*.o -o "$TMP/$name" -lm; then
+		echo "$f: FAILED, translation does not compile"
+		failed=1
+		continue
+	fi
+	printf "$INPUT" | "$EXIN" "$f" > "$TMP/$name.expected" 2> /dev/null
+	echo "exit code $?" >> "$TMP/$name.expected"
+	printf "$INPUT" | "$TMP/$name" > "$TMP/$name.actual" 2> /dev/null
+	echo "exit code $?" >> "$TMP/$name.actual"
+	if diff "$TMP/$name.expected" "$TMP/$name.actual" > /dev/null; then
+		echo "$f: ok"
+	else
+		echo "$f: FAILED, output differs"
+		diff "$TMP/$name.expected" "$TMP/$name.actual" | head -n 10
+		failed=1
+	fi
+done
+
+rm -rf "$TMP"
+exit $failed